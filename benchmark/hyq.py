@@ -16,7 +16,7 @@ GAIT = "walking"  # 115 nodes
 # GAIT = "jumping"  # 61 nodes
 
 
-def runBenchmark(gait_phase):
+def runBenchmark(gait_phase, solver):
     robot_model = example_robot_data.loadHyQ().model
     lfFoot, rfFoot, lhFoot, rhFoot = 'lf_foot', 'rf_foot', 'lh_foot', 'rh_foot'
     gait = SimpleQuadrupedalGaitProblem(robot_model, lfFoot, rfFoot, lhFoot, rhFoot)
@@ -28,27 +28,24 @@ def runBenchmark(gait_phase):
     value = gait_phase[type_of_gait]
     if type_of_gait == 'walking':
         # Creating a walking problem
-        ddp = crocoddyl.SolverDDP(
-            gait.createWalkingProblem(x0, value['stepLength'], value['stepHeight'], value['timeStep'],
-                                      value['stepKnots'], value['supportKnots']))
+        problem = gait.createWalkingProblem(x0, value['stepLength'], value['stepHeight'], value['timeStep'],
+                                            value['stepKnots'], value['supportKnots'])
     elif type_of_gait == 'trotting':
         # Creating a trotting problem
-        ddp = crocoddyl.SolverDDP(
-            gait.createTrottingProblem(x0, value['stepLength'], value['stepHeight'], value['timeStep'],
-                                       value['stepKnots'], value['supportKnots']))
+        problem = gait.createTrottingProblem(x0, value['stepLength'], value['stepHeight'], value['timeStep'],
+                                             value['stepKnots'], value['supportKnots'])
     elif type_of_gait == 'pacing':
         # Creating a pacing problem
-        ddp = crocoddyl.SolverDDP(
-            gait.createPacingProblem(x0, value['stepLength'], value['stepHeight'], value['timeStep'],
-                                     value['stepKnots'], value['supportKnots']))
+        problem = gait.createPacingProblem(x0, value['stepLength'], value['stepHeight'], value['timeStep'],
+                                           value['stepKnots'], value['supportKnots'])
     elif type_of_gait == 'bounding':
         # Creating a bounding problem
-        ddp = crocoddyl.SolverDDP(
-            gait.createBoundingProblem(x0, value['stepLength'], value['stepHeight'], value['timeStep'],
-                                       value['stepKnots'], value['supportKnots']))
+        problem = gait.createBoundingProblem(x0, value['stepLength'], value['stepHeight'], value['timeStep'],
+                                             value['stepKnots'], value['supportKnots'])
     elif type_of_gait == 'jumping':
         # Creating a jumping problem
-        ddp = crocoddyl.SolverDDP(gait.createJumpingProblem(x0, value['jumpHeight'], value['timeStep']))
+        problem = gait.createJumpingProblem(x0, value['jumpHeight'], value['timeStep'])
+    ddp = solver(problem)
 
     duration = []
     xs = [robot_model.defaultState] * len(ddp.models())
@@ -110,5 +107,6 @@ elif GAIT == 'jumping':
     GAITPHASE = {'jumping': {'jumpHeight': 0.5, 'timeStep': 1e-2}}
 
 print('cpp-wrapped contact-forward dynamics on quadruped:')
-avrg_duration, min_duration, max_duration = runBenchmark(GAITPHASE)
-print('  CPU time [ms]: {0} ({1}, {2})'.format(avrg_duration, min_duration, max_duration))
+for solver in [crocoddyl.SolverDDP, crocoddyl.SolverFDDP]:
+    avrg_duration, min_duration, max_duration = runBenchmark(GAITPHASE, solver)
+    print('  {0} CPU time [ms]: {1} ({2}, {3})'.format(solver.__name__, avrg_duration, min_duration, max_duration))
@@ -42,15 +42,25 @@ int main() {
   // Solving the optimal control problem
   std::clock_t c_start, c_end;
   Eigen::ArrayXd duration(T);
+  Eigen::ArrayXd calc_duration(T), calcDiff_duration(T), backward_duration(T), forward_duration(T);
   for (unsigned int i = 0; i < T; ++i) {
     c_start = std::clock();
     ddp.solve(xs, us, MAXITER);
     c_end = std::clock();
     duration[i] = 1e3 * (double)(c_end - c_start) / CLOCKS_PER_SEC;
+
+    const SolverTimings& timings = ddp.get_timings();
+    calc_duration[i] = timings.calc;
+    calcDiff_duration[i] = timings.calcDiff;
+    backward_duration[i] = timings.backwardPass;
+    forward_duration[i] = timings.forwardPass;
   }
 
   double avrg_duration = duration.sum() / T;
   double min_duration = duration.minCoeff();
   double max_duration = duration.maxCoeff();
   std::cout << "CPU time [ms]: " << avrg_duration << " (" << min_duration << "-" << max_duration << ")" << std::endl;
+  std::cout << "Wall time per phase [ms]: calc " << calc_duration.sum() / T << ", calcDiff "
+            << calcDiff_duration.sum() / T << ", backward pass " << backward_duration.sum() / T << ", forward pass "
+            << forward_duration.sum() / T << std::endl;
 }
\ No newline at end of file
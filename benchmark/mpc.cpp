@@ -0,0 +1,100 @@
+#include "crocoddyl/core/states/euclidean.hpp"
+#include "crocoddyl/core/actions/lqr.hpp"
+#include "crocoddyl/core/solvers/ddp.hpp"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+
+using namespace crocoddyl;
+
+// Tracking a moving reference, i.e. the cost is 0.5 * (x - r(t))^T * Lxx * (x - r(t)) + 0.5 * u^T * Luu * u
+void setReference(ActionModelLQR* model, const double& time) {
+  const Eigen::VectorXd r = Eigen::VectorXd::Constant(model->get_state().get_nx(), std::sin(time));
+  model->lx_ = -model->Lxx_ * r;
+}
+
+void printDuration(const char* name, const Eigen::ArrayXd& duration) {
+  double avrg_duration = duration.sum() / static_cast<double>(duration.size());
+  double min_duration = duration.minCoeff();
+  double max_duration = duration.maxCoeff();
+  std::cout << name << " CPU time [ms]: " << avrg_duration << " (" << min_duration << "-" << max_duration << ")"
+            << std::endl;
+}
+
+int main() {
+  unsigned int NX = 37;
+  unsigned int NU = 12;
+  unsigned int N = 100;  // number of nodes
+  unsigned int T = 2e3;  // number of MPC cycles
+  unsigned int MAXITER = 1;
+  double DT = 1e-2;
+
+  Eigen::VectorXd x0 = Eigen::VectorXd::Zero(NX);
+  std::vector<Eigen::VectorXd> xs(N + 1, x0);
+  std::vector<Eigen::VectorXd> us(N, Eigen::VectorXd::Zero(NU));
+  std::vector<ActionModelAbstract*> runningModels;
+  for (unsigned int i = 0; i < N; ++i) {
+    ActionModelLQR* model_i = new ActionModelLQR(NX, NU);
+    model_i->Lxu_.setZero();
+    model_i->lu_.setZero();
+    setReference(model_i, i * DT);
+    runningModels.push_back(model_i);
+  }
+  ActionModelLQR* terminalModel = new ActionModelLQR(NX, NU);
+  terminalModel->Lxu_.setZero();
+  terminalModel->lu_.setZero();
+  std::clock_t c_start, c_end;
+
+  // Rebuilding the problem and solver in each cycle, and copying the shifted warm start
+  {
+    Eigen::ArrayXd duration(T);
+    std::vector<ActionModelAbstract*> models(runningModels);
+    Eigen::VectorXd x = x0;
+    for (unsigned int i = 0; i < T; ++i) {
+      c_start = std::clock();
+      ShootingProblem problem(x, models, terminalModel);
+      SolverDDP ddp(problem);
+      ddp.solve(xs, us, MAXITER);
+      for (unsigned int t = 0; t < N; ++t) {
+        xs[t] = ddp.get_xs()[t + 1];
+      }
+      for (unsigned int t = 0; t + 1 < N; ++t) {
+        us[t] = ddp.get_us()[t + 1];
+      }
+      c_end = std::clock();
+      duration[i] = 1e3 * (double)(c_end - c_start) / CLOCKS_PER_SEC;
+
+      // Moving the reference and the measured state
+      x = ddp.get_xs()[1];
+      std::rotate(models.begin(), models.begin() + 1, models.end());
+      setReference(static_cast<ActionModelLQR*>(models.back()), (i + N) * DT);
+    }
+    printDuration("rebuild", duration);
+  }
+
+  // Shifting the horizon in place
+  {
+    for (unsigned int i = 0; i < N; ++i) {
+      setReference(static_cast<ActionModelLQR*>(runningModels[i]), i * DT);
+    }
+    Eigen::ArrayXd duration(T);
+    ShootingProblem problem(x0, runningModels, terminalModel);
+    SolverDDP ddp(problem);
+    ddp.solve(DEFAULT_VECTOR, DEFAULT_VECTOR, MAXITER);
+    Eigen::VectorXd x = x0;
+    for (unsigned int i = 0; i < T; ++i) {
+      c_start = std::clock();
+      problem.set_x0(x);
+      ddp.solve(ddp.get_xs(), ddp.get_us(), MAXITER);
+      ddp.shiftHorizon();
+      c_end = std::clock();
+      duration[i] = 1e3 * (double)(c_end - c_start) / CLOCKS_PER_SEC;
+
+      // Moving the reference and the measured state
+      x = ddp.get_xs()[0];
+      setReference(static_cast<ActionModelLQR*>(problem.running_models_.back()), (i + N) * DT);
+    }
+    printDuration("shift", duration);
+  }
+}
@@ -0,0 +1,155 @@
+#include "crocoddyl/core/states/euclidean.hpp"
+#include "crocoddyl/core/actions/lqr.hpp"
+#include "crocoddyl/core/solvers/ddp.hpp"
+#include "crocoddyl/core/utils/timer.hpp"
+#include <iostream>
+#include <vector>
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#include <omp.h>
+#endif
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+using namespace crocoddyl;
+
+// Counter of the cache misses of this thread, it reads -1 if the kernel doesn't allow to count them
+class CacheMissCounter {
+ public:
+  CacheMissCounter() : fd_(-1) {
+#ifdef __linux__
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd_ = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+  ~CacheMissCounter() {
+#ifdef __linux__
+    if (fd_ != -1) close(fd_);
+#endif
+  }
+
+  void start() {
+#ifdef __linux__
+    if (fd_ != -1) {
+      ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+      ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  long long stop() {
+    long long count = -1;
+#ifdef __linux__
+    if (fd_ != -1) {
+      ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+      if (read(fd_, &count, sizeof(count)) != sizeof(count)) count = -1;
+    }
+#endif
+    return count;
+  }
+
+ private:
+  int fd_;
+};
+
+// Exposing the backward pass of the solver, the derivatives are computed only once
+class BenchmarkDDP : public SolverDDP {
+ public:
+  explicit BenchmarkDDP(ShootingProblem& problem) : SolverDDP(problem) {}
+  void set_regularization(const double& reg) {
+    xreg_ = reg;
+    ureg_ = reg;
+  }
+};
+
+// Return the mean wall time of each horizon, and print the speedup with respect to the serial times (if any)
+std::vector<double> runBenchmark(const bool& sqrt_riccati, const unsigned int& nthreads, CacheMissCounter& counter,
+                                 const std::vector<double>& serial_times = std::vector<double>()) {
+  unsigned int NX = 37;
+  unsigned int NU = 12;
+  unsigned int TRIALS = 200;
+  const unsigned int horizons[] = {100, 200, 500, 1000};
+
+  std::cout << (sqrt_riccati ? "Square-root b" : "B") << "ackward pass of the LQR problem with nx=" << NX
+            << " and nu=" << NU;
+  if (nthreads > 1) {
+    std::cout << ", partitioned over " << nthreads << " threads";
+  }
+  std::cout << std::endl;
+  std::vector<double> times;
+  for (unsigned int h = 0; h < sizeof(horizons) / sizeof(horizons[0]); ++h) {
+    const unsigned int N = horizons[h];
+    Eigen::VectorXd x0 = Eigen::VectorXd::Zero(NX);
+    std::vector<Eigen::VectorXd> xs(N + 1, x0);
+    std::vector<Eigen::VectorXd> us(N, Eigen::VectorXd::Zero(NU));
+    std::vector<ActionModelAbstract*> runningModels;
+    for (unsigned int i = 0; i < N; ++i) {
+      runningModels.push_back(new ActionModelLQR(NX, NU));
+    }
+    ActionModelLQR terminalModel(NX, NU);
+    ShootingProblem problem(x0, runningModels, &terminalModel);
+    BenchmarkDDP ddp(problem);
+    ddp.set_sqrt_riccati(sqrt_riccati);
+    ddp.set_nthreads_riccati(nthreads);
+    ddp.setCandidate(xs, us, true);
+    ddp.set_regularization(1e-9);
+    ddp.calc();
+    ddp.backwardPass();
+
+    Eigen::ArrayXd duration(TRIALS);
+    long long misses = 0;
+    Timer timer;
+    for (unsigned int i = 0; i < TRIALS; ++i) {
+      counter.start();
+      timer.reset();
+      ddp.backwardPass();
+      duration[i] = timer.get_duration();
+      const long long count = counter.stop();
+      misses = count < 0 || misses < 0 ? -1 : misses + count;
+    }
+
+    times.push_back(duration.sum() / TRIALS);
+    std::cout << "T=" << N << ": wall time [ms]: " << times.back() << " (" << duration.minCoeff() << "-"
+              << duration.maxCoeff() << "), ";
+    if (h < serial_times.size()) {
+      std::cout << "speedup: " << serial_times[h] / times.back() << ", ";
+    }
+    std::cout << "cache misses per node: ";
+    if (misses < 0) {
+      std::cout << "n/a";
+    } else {
+      std::cout << static_cast<double>(misses) / (static_cast<double>(TRIALS) * N);
+    }
+    std::cout << std::endl;
+
+    for (unsigned int i = 0; i < N; ++i) {
+      delete runningModels[i];
+    }
+  }
+  return times;
+}
+
+int main() {
+  CacheMissCounter counter;
+  const std::vector<double> serial_times = runBenchmark(false, 1, counter);
+  runBenchmark(true, 1, counter);
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  // The speedup is only meaningful if there are as many cores as threads
+  std::cout << "Available cores: " << omp_get_num_procs() << std::endl;
+  const unsigned int threads[] = {4, 8, 16};
+  for (unsigned int i = 0; i < sizeof(threads) / sizeof(threads[0]); ++i) {
+    runBenchmark(false, threads[i], counter, serial_times);
+  }
+#endif
+}
@@ -12,7 +12,7 @@ MAXITER = 1
 GAIT = "walking"  # 55 nodes
 
 
-def runBenchmark(gait_phase):
+def runBenchmark(gait_phase, solver, sqrtRiccati=False):
     robot_model = example_robot_data.loadTalosLegs().model
     rightFoot, leftFoot = 'right_sole_link', 'left_sole_link'
     gait = SimpleBipedGaitProblem(robot_model, rightFoot, leftFoot)
@@ -24,11 +24,13 @@ def runBenchmark(gait_phase):
     value = gait_phase[type_of_gait]
     if type_of_gait == 'walking':
         # Creating a walking problem
-        ddp = crocoddyl.SolverDDP(
-            gait.createWalkingProblem(x0, value['stepLength'], value['stepHeight'], value['timeStep'],
-                                      value['stepKnots'], value['supportKnots']))
+        problem = gait.createWalkingProblem(x0, value['stepLength'], value['stepHeight'], value['timeStep'],
+                                            value['stepKnots'], value['supportKnots'])
+    ddp = solver(problem)
+    ddp.sqrtRiccati = sqrtRiccati
 
     duration = []
+    retries = []
     xs = [robot_model.defaultState] * len(ddp.models())
     us = [m.quasicStatic(d, robot_model.defaultState) for m, d in list(zip(ddp.models(), ddp.datas()))[:-1]]
     for i in range(T):
@@ -36,11 +38,16 @@ def runBenchmark(gait_phase):
         ddp.solve(xs, us, MAXITER, False, 0.1)
         c_end = time.time()
         duration.append(1e3 * (c_end - c_start))
+        retries.append(ddp.timings.nregularizations)
 
     avrg_duration = sum(duration) / len(duration)
     min_duration = min(duration)
     max_duration = max(duration)
-    return avrg_duration, min_duration, max_duration
+    avrg_retries = float(sum(retries)) / len(retries)
+
+    # Regularization retries until convergence
+    ddp.solve(xs, us, 100, False, 0.1)
+    return avrg_duration, min_duration, max_duration, avrg_retries, ddp.iter, ddp.timings.nregularizations
 
 
 # Setting up all tasks
@@ -55,6 +62,12 @@ if GAIT == 'walking':
         }
     }
 
-print('cpp-wrapped contact-forward dynamics on quadruped:')
-avrg_duration, min_duration, max_duration = runBenchmark(GAITPHASE)
-print('  CPU time [ms]: {0} ({1}, {2})'.format(avrg_duration, min_duration, max_duration))
+print('cpp-wrapped contact-forward dynamics on biped:')
+for solver in [crocoddyl.SolverDDP, crocoddyl.SolverFDDP]:
+    for sqrtRiccati in [False, True]:
+        avrg_duration, min_duration, max_duration, avrg_retries, iters, retries = runBenchmark(
+            GAITPHASE, solver, sqrtRiccati)
+        name = solver.__name__ + (' (square-root Riccati)' if sqrtRiccati else '')
+        print('  {0} CPU time [ms]: {1} ({2}, {3})'.format(name, avrg_duration, min_duration, max_duration))
+        print('    regularization retries: {0} per solve, {1} until convergence ({2} iterations)'.format(
+            avrg_retries, retries, iters))
@@ -26,7 +26,14 @@
 #include "python/crocoddyl/core/activations/quadratic.hpp"
 #include "python/crocoddyl/core/activations/weighted-quadratic.hpp"
 #include "python/crocoddyl/core/solvers/ddp.hpp"
+#include "python/crocoddyl/core/solvers/fddp.hpp"
+#include "python/crocoddyl/core/solvers/box-ddp.hpp"
+#include "python/crocoddyl/core/solvers/kkt.hpp"
+#include "python/crocoddyl/core/solvers/batch.hpp"
 #include "python/crocoddyl/core/utils/callbacks.hpp"
+#include "python/crocoddyl/core/utils/trace.hpp"
+#include "python/crocoddyl/core/utils/policy.hpp"
+#include "python/crocoddyl/core/utils/solution-publisher.hpp"
 
 namespace crocoddyl {
 namespace python {
@@ -49,7 +56,14 @@ void exposeCore() {
   exposeActivationQuad();
   exposeActivationWeightedQuad();
   exposeSolverDDP();
+  exposeSolverFDDP();
+  exposeSolverBoxDDP();
+  exposeSolverKKT();
+  exposeSolverBatch();
   exposeCallbacks();
+  exposeTrace();
+  exposePolicy();
+  exposeSolutionPublisher();
 }
 
 }  // namespace python
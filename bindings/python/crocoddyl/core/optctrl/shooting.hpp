@@ -19,6 +19,8 @@ namespace python {
 
 namespace bp = boost::python;
 
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(ShootingProblem_calcDiff_wraps, ShootingProblem::calcDiff, 2, 3)
+
 void exposeShootingProblem() {
   // Register custom converters between std::vector and Python list
   typedef ActionModelAbstract* ActionModelPtr;
@@ -51,19 +53,51 @@ void exposeShootingProblem() {
            ":param xs: time-discrete state trajectory\n"
            ":param us: time-discrete control sequence\n"
            ":returns the total cost value")
-      .def("calcDiff", &ShootingProblem::calcDiff, bp::args(" self", " xs", " us"),
-           "Compute the cost-and-dynamics derivatives.\n\n"
-           "These quantities are computed along a given pair of trajectories xs\n"
-           "(states) and us (controls).\n"
-           ":param xs: time-discrete state trajectory\n"
-           ":param us: time-discrete control sequence")
+      .def("calcDiff", &ShootingProblem::calcDiff,
+           ShootingProblem_calcDiff_wraps(bp::args(" self", " xs", " us", " recalc=True"),
+                                          "Compute the cost-and-dynamics derivatives.\n\n"
+                                          "These quantities are computed along a given pair of trajectories xs\n"
+                                          "(states) and us (controls).\n"
+                                          ":param xs: time-discrete state trajectory\n"
+                                          ":param us: time-discrete control sequence\n"
+                                          ":param recalc: true if calc has not been run along xs and us\n"
+                                          ":returns the total cost value\n"
+                                          "The derivatives of a node are reused if its state and control are\n"
+                                          "within relinearizationTolerance of its last linearization."))
       .def("rollout", &ShootingProblem::rollout_us, bp::args(" self", " us"),
            "Integrate the dynamics given a control sequence.\n\n"
            "Rollout the dynamics give a sequence of control commands\n"
            ":param us: time-discrete control sequence")
       .add_property("T", bp::make_function(&ShootingProblem::get_T), "number of nodes")
+      .def("circularAppend", &ShootingProblem::circularAppend, bp::with_custodian_and_ward<1, 2>(),
+           bp::args(" self", " model", " data"),
+           "Shift the horizon by one node.\n\n"
+           "It drops the first node and appends the node defined by (model, data). The nodes are\n"
+           "rotated in place, so the first model and data can be recycled as last node.\n"
+           ":param model: action model of the last node\n"
+           ":param data: action data of the last node")
+      .def("invalidateLinearization", &ShootingProblem::invalidateLinearization, bp::args(" self", " node"),
+           "Force the next calcDiff to evaluate the derivatives of a node.\n\n"
+           "It has to be called after changing the parameters of the node's model (e.g. its cost reference)\n"
+           "if the derivatives are reused.\n"
+           ":param node: node index (T for the terminal node)")
+      .def("invalidateLinearizations", &ShootingProblem::invalidateLinearizations, bp::args(" self"),
+           "Force the next calcDiff to evaluate the derivatives of all the nodes.")
       .add_property("x0", bp::make_function(&ShootingProblem::get_x0, bp::return_value_policy<bp::return_by_value>()),
-                    "initial state")
+                    &ShootingProblem::set_x0, "initial state")
+      .add_property("nthreads",
+                    bp::make_function(&ShootingProblem::get_nthreads, bp::return_value_policy<bp::return_by_value>()),
+                    &ShootingProblem::set_nthreads,
+                    "number of threads used for evaluating the nodes in calc and calcDiff (1 by default)")
+      .add_property("relinearizationTolerance",
+                    bp::make_function(&ShootingProblem::get_relinearization_tolerance,
+                                      bp::return_value_policy<bp::return_by_value>()),
+                    &ShootingProblem::set_relinearization_tolerance,
+                    "tolerance (infinity norm) on the state and control changes of a node under which calcDiff\n"
+                    "reuses its derivatives (NaN by default, i.e. they are always evaluated)")
+      .add_property("nreused",
+                    bp::make_function(&ShootingProblem::get_nreused, bp::return_value_policy<bp::return_by_value>()),
+                    "number of nodes whose derivatives were reused by the last calcDiff")
       .add_property(
           "runningModels",
           bp::make_function(&ShootingProblem::get_runningModels, bp::return_value_policy<bp::return_by_value>()),
@@ -77,6 +77,38 @@ class CallbackAbstract_wrap : public CallbackAbstract, public bp::wrapper<Callba
   }
 };
 
+typedef boost::shared_ptr<const SolverAbstract::HistoryMatrix> HistoryStorage;
+
+#if PY_MAJOR_VERSION >= 3
+void SolverAbstract_releaseHistory(PyObject* capsule) {
+  delete static_cast<HistoryStorage*>(PyCapsule_GetPointer(capsule, NULL));
+}
+#else
+void SolverAbstract_releaseHistory(void* storage) { delete static_cast<HistoryStorage*>(storage); }
+#endif
+
+bp::object SolverAbstract_history(const SolverAbstract& self) {
+  // The numpy array is a view of the history of the solver, so there is no copy
+  const SolverAbstract::HistoryMap history = self.get_history();
+  char* data = reinterpret_cast<char*>(const_cast<double*>(history.data()));
+  const Py_ssize_t size = static_cast<Py_ssize_t>(sizeof(double) * history.size());
+  HistoryStorage* owner = new HistoryStorage(self.get_history_storage());
+#if PY_MAJOR_VERSION >= 3
+  bp::object buffer(bp::handle<>(PyMemoryView_FromMemory(data, size, PyBUF_READ)));
+  bp::object storage(bp::handle<>(PyCapsule_New(owner, NULL, &SolverAbstract_releaseHistory)));
+#else
+  bp::object buffer(bp::handle<>(PyBuffer_FromMemory(data, size)));
+  bp::object storage(bp::handle<>(PyCObject_FromVoidPtr(owner, &SolverAbstract_releaseHistory)));
+#endif
+  bp::object array = bp::import("numpy").attr("frombuffer")(buffer, "float64");
+  array = array.attr("reshape")(history.rows(), static_cast<int>(SolverHistoryNbFields));
+  // The array keeps the storage alive, so it remains valid if the capacity of the history is changed
+  if (bp::objects::make_nurse_and_patient(array.ptr(), storage.ptr()) == NULL) {
+    bp::throw_error_already_set();
+  }
+  return array;
+}
+
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(setCandidate_overloads, SolverAbstract::setCandidate, 0, 3)
 
 void exposeSolverAbstract() {
@@ -85,6 +117,49 @@ void exposeSolverAbstract() {
                           vector_to_list<CallbackAbstract*> >();
   list_to_vector().from_python<std::vector<CallbackAbstract*, std::allocator<CallbackAbstract*> > >();
 
+  bp::enum_<SolverStatus>("SolverStatus")
+      .value("Success", SolverStatusSuccess)
+      .value("BackwardError", SolverStatusBackwardError)
+      .value("ForwardError", SolverStatusForwardError)
+      .value("StepRejected", SolverStatusStepRejected);
+
+  bp::enum_<SolverHistoryField>("SolverHistoryField")
+      .value("Cost", SolverHistoryCost)
+      .value("Stop", SolverHistoryStop)
+      .value("StepLength", SolverHistoryStepLength)
+      .value("XReg", SolverHistoryXReg)
+      .value("UReg", SolverHistoryUReg)
+      .value("DV", SolverHistoryDV)
+      .value("DVexp", SolverHistoryDVexp)
+      .value("Feasible", SolverHistoryFeasible)
+      .value("Calc", SolverHistoryCalc)
+      .value("CalcDiff", SolverHistoryCalcDiff)
+      .value("BackwardPass", SolverHistoryBackwardPass)
+      .value("ForwardPass", SolverHistoryForwardPass);
+
+  bp::class_<SolverTimings>(
+      "SolverTimings",
+      "Wall time [ms] and number of calls of the phases of a solver.\n\n"
+      "calc and calcDiff are the evaluations of the actions and of their derivatives, backwardPass\n"
+      "computes the search direction and forwardPass the line-search rollouts. The number of\n"
+      "line-search trials and of regularization retries (i.e. recomputed search directions) are\n"
+      "recorded too, as well as the number of node derivatives that were evaluated and reused.",
+      bp::init<>(bp::args(" self"), "Initialize the timings to zero."))
+      .def_readonly("calc", &SolverTimings::calc, "time of calc [ms]")
+      .def_readonly("calcDiff", &SolverTimings::calcDiff, "time of calcDiff [ms]")
+      .def_readonly("backwardPass", &SolverTimings::backwardPass, "time of the backward pass [ms]")
+      .def_readonly("forwardPass", &SolverTimings::forwardPass, "time of the forward pass [ms]")
+      .def_readonly("ncalc", &SolverTimings::ncalc, "number of calls of calc")
+      .def_readonly("ncalcDiff", &SolverTimings::ncalcDiff, "number of calls of calcDiff")
+      .def_readonly("nbackwardPass", &SolverTimings::nbackwardPass, "number of backward passes")
+      .def_readonly("nforwardPass", &SolverTimings::nforwardPass, "number of forward passes")
+      .def_readonly("ntrials", &SolverTimings::ntrials, "number of line-search trials")
+      .def_readonly("nregularizations", &SolverTimings::nregularizations, "number of regularization retries")
+      .def_readonly("nlinearizations", &SolverTimings::nlinearizations,
+                    "number of nodes whose derivatives were evaluated")
+      .def_readonly("nreuses", &SolverTimings::nreuses, "number of nodes whose derivatives were reused")
+      .add_property("reuseRatio", &SolverTimings::reuseRatio, "ratio of node derivatives that were reused");
+
   bp::class_<SolverAbstract_wrap, boost::noncopyable>(
       "SolverAbstract",
       "Abstract class for optimal control solvers.\n\n"
@@ -151,6 +226,17 @@ void exposeSolverAbstract() {
                                   ":param us: control trajectory of T elements.\n"
                                   ":param isFeasible: true if the xs are obtained from integrating the\n"
                                   "us (rollout)."))
+      .def<void (SolverAbstract::*)(ActionModelAbstract*, const boost::shared_ptr<ActionDataAbstract>&)>(
+          "shiftHorizon", &SolverAbstract::shiftHorizon, bp::with_custodian_and_ward<1, 2>(),
+          bp::args(" self", " model", " data"),
+          "Shift the horizon by one node for receding-horizon control.\n\n"
+          "It appends (model, data) as last node of the problem, and it rotates the candidate\n"
+          "(xs, us) in place. The new last node is warm-started by the solver, e.g. from its\n"
+          "feedback policy. Then, the next solve can be warm-started from (xs, us).\n"
+          ":param model: action model of the last node\n"
+          ":param data: action data of the last node")
+      .def<void (SolverAbstract::*)()>("shiftHorizon", &SolverAbstract::shiftHorizon, bp::args(" self"),
+                                       "Shift the horizon by one node by recycling the first node as last node.")
       .def("setCallbacks", &SolverAbstract_wrap::setCallbacks, bp::args(" self"),
            "Set a list of callback functions using for diagnostic.\n\n"
            "Each iteration, the solver calls these set of functions in order to\n"
@@ -167,11 +253,52 @@ void exposeSolverAbstract() {
                     bp::make_setter(&SolverAbstract_wrap::us_, bp::return_value_policy<bp::return_by_value>()),
                     "control sequence")
       .def_readwrite("isFeasible", &SolverAbstract_wrap::is_feasible_, "feasible (xs,us)")
+      .add_property("isAccepted",
+                    bp::make_function(&SolverAbstract_wrap::get_isAccepted,
+                                      bp::return_value_policy<bp::copy_const_reference>()),
+                    "true if the last iteration accepted a step")
       .def_readwrite("x_reg", &SolverAbstract_wrap::xreg_, "state regularization")
       .def_readwrite("u_reg", &SolverAbstract_wrap::ureg_, "control regularization")
       .def_readwrite("th_acceptStep", &SolverAbstract_wrap::th_acceptstep_, "threshold for step acceptance")
       .def_readwrite("th_stop", &SolverAbstract_wrap::th_stop_, "threshold for stopping criteria")
-      .def_readwrite("iter", &SolverAbstract_wrap::iter_, "number of iterations runned in solve()");
+      .def_readwrite("iter", &SolverAbstract_wrap::iter_, "number of iterations runned in solve()")
+      .add_property("timings",
+                    bp::make_function(&SolverAbstract_wrap::get_timings,
+                                      bp::return_value_policy<bp::copy_const_reference>()),
+                    "cumulative timings of the last solve()")
+      .add_property("iterTimings",
+                    bp::make_function(&SolverAbstract_wrap::get_iterTimings,
+                                      bp::return_value_policy<bp::copy_const_reference>()),
+                    "timings of the last iteration")
+      .add_property("status",
+                    bp::make_function(&SolverAbstract_wrap::get_status,
+                                      bp::return_value_policy<bp::copy_const_reference>()),
+                    "status of the last backward or forward pass")
+      .add_property("failedNode",
+                    bp::make_function(&SolverAbstract_wrap::get_failedNode,
+                                      bp::return_value_policy<bp::copy_const_reference>()),
+                    "node where the last pass failed, or -1")
+      .add_property("timeBudget",
+                    bp::make_function(&SolverAbstract_wrap::get_time_budget,
+                                      bp::return_value_policy<bp::copy_const_reference>()),
+                    &SolverAbstract_wrap::set_time_budget,
+                    "wall time given to each solve [ms] (inf by default).\n\n"
+                    "The solver doesn't start an iteration or a line-search trial whose predicted\n"
+                    "duration exceeds the remaining budget, and it doesn't accept a step\n"
+                    "without time left for its search direction.")
+      .add_property("stoppedByBudget",
+                    bp::make_function(&SolverAbstract_wrap::get_stoppedByBudget,
+                                      bp::return_value_policy<bp::copy_const_reference>()),
+                    "true if the last solve was stopped by its time budget")
+      .add_property("history", bp::make_function(&SolverAbstract_history, bp::with_custodian_and_ward_postcall<0, 1>()),
+                    "convergence history of the last solve.\n\n"
+                    "It is a read-only numpy array, with one row per iteration and one column per\n"
+                    "SolverHistoryField. It is a view of the solver memory, which is overwritten by\n"
+                    "the next solve. If historyCapacity is changed, the existing views keep the previous\n"
+                    "history.")
+      .add_property("historyCapacity", &SolverAbstract_wrap::get_history_capacity,
+                    &SolverAbstract_wrap::set_history_capacity,
+                    "number of iterations kept in the convergence history (256 by default)");
 
   bp::class_<CallbackAbstract_wrap, boost::noncopyable>(
       "CallbackAbstract",
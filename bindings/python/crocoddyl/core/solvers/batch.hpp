@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BINDINGS_PYTHON_CROCODDYL_CORE_SOLVERS_BATCH_HPP_
+#define BINDINGS_PYTHON_CROCODDYL_CORE_SOLVERS_BATCH_HPP_
+
+#include "crocoddyl/core/solvers/batch.hpp"
+
+namespace crocoddyl {
+namespace python {
+
+namespace bp = boost::python;
+
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(SolverBatch_solves, SolverBatch::solve, 1, 6)
+
+SolverFDDP& SolverBatch_solver(SolverBatch& self, const std::size_t& i) {
+  if (i >= self.get_solvers().size()) {
+    PyErr_SetString(PyExc_IndexError, "Invalid thread index");
+    bp::throw_error_already_set();
+  }
+  return *self.get_solvers()[i];
+}
+
+bp::list SolverBatch_iters(const SolverBatch& self) {
+  bp::list iters;
+  for (std::size_t i = 0; i < self.get_iters().size(); ++i) {
+    iters.append(self.get_iters()[i]);
+  }
+  return iters;
+}
+
+bp::list SolverBatch_converged(const SolverBatch& self) {
+  bp::list converged;
+  for (std::size_t i = 0; i < self.get_converged().size(); ++i) {
+    converged.append(static_cast<bool>(self.get_converged()[i]));
+  }
+  return converged;
+}
+
+void exposeSolverBatch() {
+  bp::class_<SolverBatch, boost::noncopyable>(
+      "SolverBatch",
+      "Batch of FDDP solves of a shooting problem from many initial states.\n\n"
+      "The models of the problem are shared by all the solves, and each thread has its own\n"
+      "problem datas and FDDP solver. The solutions are stored column-wise, i.e. the column i\n"
+      "of xs (us) stacks the states (controls) of the solution of x0s[i] node by node.",
+      bp::init<ShootingProblem&, bp::optional<unsigned int> >(
+          bp::args(" self", " problem", " nthreads=1"),
+          "Initialize the solvers of each thread.\n\n"
+          ":param problem: shooting problem, its models are shared by the solves\n"
+          ":param nthreads: number of threads")[bp::with_custodian_and_ward<1, 2>()])
+      .def("solve", &SolverBatch::solve,
+           SolverBatch_solves(bp::args(" self", " x0s", " init_xs", " init_us", " maxiter=100",
+                                       " isFeasible=False", " regInit=None"),
+                              "Solve the problem for each initial state.\n\n"
+                              ":param x0s: list of initial states\n"
+                              ":param init_xs: warm start of the states in the layout of xs (optional)\n"
+                              ":param init_us: warm start of the controls in the layout of us (optional)\n"
+                              ":param maxiter: maximun allowed number of iterations of each solve.\n"
+                              ":param isFeasible: true if the init_xs are obtained from integrating the init_us.\n"
+                              ":param regInit: initial guess for the regularization value.\n"
+                              ":returns true if all the solves converged."))
+      .def("solver", &SolverBatch_solver, bp::return_internal_reference<>(), bp::args(" self", " thread"),
+           "Return the solver of a thread, e.g. for setting its thresholds.\n\n"
+           ":param thread: thread index")
+      .add_property("nthreads",
+                    bp::make_function(&SolverBatch::get_nthreads, bp::return_value_policy<bp::copy_const_reference>()),
+                    &SolverBatch::set_nthreads, "number of threads")
+      .add_property("xs", bp::make_function(&SolverBatch::get_xs, bp::return_value_policy<bp::copy_const_reference>()),
+                    "state trajectories (one per column)")
+      .add_property("us", bp::make_function(&SolverBatch::get_us, bp::return_value_policy<bp::copy_const_reference>()),
+                    "control sequences (one per column)")
+      .add_property("costs",
+                    bp::make_function(&SolverBatch::get_costs, bp::return_value_policy<bp::copy_const_reference>()),
+                    "cost of each solution")
+      .add_property("stops",
+                    bp::make_function(&SolverBatch::get_stops, bp::return_value_policy<bp::copy_const_reference>()),
+                    "stopping criteria of each solution")
+      .add_property("iters", &SolverBatch_iters, "number of iterations of each solve")
+      .add_property("converged", &SolverBatch_converged, "true for each solve that converged")
+      .add_property("duration",
+                    bp::make_function(&SolverBatch::get_duration, bp::return_value_policy<bp::copy_const_reference>()),
+                    "wall time of the last batch [ms]")
+      .add_property("throughput", &SolverBatch::get_throughput, "number of solves per second of the last batch");
+}
+
+}  // namespace python
+}  // namespace crocoddyl
+
+#endif  // BINDINGS_PYTHON_CROCODDYL_CORE_SOLVERS_BATCH_HPP_
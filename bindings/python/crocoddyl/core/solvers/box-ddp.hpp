@@ -0,0 +1,55 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BINDINGS_PYTHON_CROCODDYL_CORE_SOLVERS_BOX_DDP_HPP_
+#define BINDINGS_PYTHON_CROCODDYL_CORE_SOLVERS_BOX_DDP_HPP_
+
+#include "crocoddyl/core/solvers/box-ddp.hpp"
+
+namespace crocoddyl {
+namespace python {
+
+namespace bp = boost::python;
+
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(SolverBoxDDP_forwardPasses, SolverDDP::forwardPass, 1, 2)
+
+void exposeSolverBoxDDP() {
+  bp::class_<SolverBoxDDP, bp::bases<SolverDDP> >(
+      "SolverBoxDDP",
+      "Control-limited DDP solver.\n\n"
+      "It runs the control-limited DDP proposed in Tassa, Mansard and Todorov,\n"
+      "'Control-Limited Differential Dynamic Programming', ICRA 2014. The feed-forward\n"
+      "terms are computed by a projected-Newton box QP warm-started from the previous\n"
+      "iteration, the feedback gains of the clamped controls are zero, and the forward-pass\n"
+      "clamps the controls inside the limits (ul, uu). By default there are no limits.\n"
+      ":param shootingProblem: shooting problem (list of action models along trajectory.)",
+      bp::init<ShootingProblem&>(bp::args(" self", " problem"),
+                                 "Initialize the vector dimension.\n\n"
+                                 ":param problem: shooting problem.")[bp::with_custodian_and_ward<1, 2>()])
+      .def("stoppingCriteria", &SolverBoxDDP::stoppingCriteria, bp::args(" self"),
+           "Return a sum of positive parameters whose sum quantifies the DDP termination.\n\n"
+           "It doesn't consider the gradient of the controls that are pushed against their limits.")
+      .def("forwardPass", &SolverBoxDDP::forwardPass,
+           SolverBoxDDP_forwardPasses(
+               bp::args(" self", " stepLength", " costMax=inf"),
+               "Run the forward pass or rollout\n\n"
+               "It rollouts the action model give the computed policy (feedfoward terns and feedback\n"
+               "gains) by the backwardPass. The controls are clamped inside the limits.\n"
+               ":param stepLength: applied step length (<= 1. and >= 0.)\n"
+               ":param costMax: cost above which the step is rejected\n"
+               ":returns the status of the rollout (the diverged node is given by failedNode)."))
+      .add_property("ul", bp::make_function(&SolverBoxDDP::get_ul, bp::return_value_policy<bp::copy_const_reference>()),
+                    &SolverBoxDDP::set_ul, "lower control limits")
+      .add_property("uu", bp::make_function(&SolverBoxDDP::get_uu, bp::return_value_policy<bp::copy_const_reference>()),
+                    &SolverBoxDDP::set_uu, "upper control limits");
+}
+
+}  // namespace python
+}  // namespace crocoddyl
+
+#endif  // BINDINGS_PYTHON_CROCODDYL_CORE_SOLVERS_BOX_DDP_HPP_
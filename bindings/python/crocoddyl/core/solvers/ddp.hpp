@@ -19,6 +19,7 @@ namespace bp = boost::python;
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(SolverDDP_solves, SolverDDP::solve, 0, 5)
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(SolverDDP_computeDirections, SolverDDP::computeDirection, 0, 1)
 BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(SolverDDP_trySteps, SolverDDP::tryStep, 0, 1)
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(SolverDDP_forwardPasses, SolverDDP::forwardPass, 1, 2)
 
 void exposeSolverDDP() {
   bp::class_<SolverDDP, bp::bases<SolverAbstract> >(
@@ -78,12 +79,18 @@ void exposeSolverDDP() {
       .def("backwardPass", &SolverDDP::backwardPass, bp::args(" self"),
            "Run the backward pass (Riccati sweep)\n\n"
            "It assumes that the Jacobian and Hessians of the optimal control problem have been\n"
-           "compute. These terms are computed by running calc.")
-      .def("forwardPass", &SolverDDP::forwardPass, bp::args(" self", " stepLength=1"),
-           "Run the forward pass or rollout\n\n"
-           "It rollouts the action model give the computed policy (feedfoward terns and feedback\n"
-           "gains) by the backwardPass. We can define different step lengths\n"
-           ":param stepLength: applied step length (<= 1. and >= 0.)")
+           "compute. These terms are computed by running calc.\n"
+           ":returns the status of the sweep (the failed node is given by failedNode).")
+      .def("forwardPass", &SolverDDP::forwardPass,
+           SolverDDP_forwardPasses(
+               bp::args(" self", " stepLength", " costMax=inf"),
+               "Run the forward pass or rollout\n\n"
+               "It rollouts the action model give the computed policy (feedfoward terns and feedback\n"
+               "gains) by the backwardPass. We can define different step lengths. The rollout is\n"
+               "stopped (StepRejected) once its cost is known to exceed costMax, see costLowerBound.\n"
+               ":param stepLength: applied step length (<= 1. and >= 0.)\n"
+               ":param costMax: cost above which the step is rejected\n"
+               ":returns the status of the rollout (the diverged node is given by failedNode)."))
       .add_property("Vxx", make_function(&SolverDDP::get_Vxx, bp::return_value_policy<bp::copy_const_reference>()),
                     "Vxx")
       .add_property("Vx", make_function(&SolverDDP::get_Vx, bp::return_value_policy<bp::copy_const_reference>()), "Vx")
@@ -96,7 +103,30 @@ void exposeSolverDDP() {
       .add_property("Qx", make_function(&SolverDDP::get_Qx, bp::return_value_policy<bp::copy_const_reference>()), "Qx")
       .add_property("Qu", make_function(&SolverDDP::get_Qu, bp::return_value_policy<bp::copy_const_reference>()), "Qu")
       .add_property("K", make_function(&SolverDDP::get_K, bp::return_value_policy<bp::copy_const_reference>()), "K")
-      .add_property("k", make_function(&SolverDDP::get_k, bp::return_value_policy<bp::copy_const_reference>()), "k");
+      .add_property("k", make_function(&SolverDDP::get_k, bp::return_value_policy<bp::copy_const_reference>()), "k")
+      .add_property("nthreadsLineSearch",
+                    bp::make_function(&SolverDDP::get_nthreads_linesearch,
+                                      bp::return_value_policy<bp::return_by_value>()),
+                    &SolverDDP::set_nthreads_linesearch,
+                    "number of step lengths rolled out in parallel by the line search (1 by default)")
+      .add_property("nthreadsRiccati",
+                    bp::make_function(&SolverDDP::get_nthreads_riccati, bp::return_value_policy<bp::return_by_value>()),
+                    &SolverDDP::set_nthreads_riccati,
+                    "number of segments of the horizon solved in parallel by the backward pass (1 by default).\n\n"
+                    "The partitioned backward pass computes the same gains as the serial one, and it needs\n"
+                    "Luu + ureg to be positive definite.")
+      .add_property("sqrtRiccati",
+                    bp::make_function(&SolverDDP::get_sqrt_riccati, bp::return_value_policy<bp::return_by_value>()),
+                    &SolverDDP::set_sqrt_riccati,
+                    "true if the backward pass propagates the Cholesky factor of Vxx (false by default).\n\n"
+                    "It requires positive semidefinite cost Hessians, e.g. Gauss-Newton approximations.")
+      .add_property("costLowerBound",
+                    bp::make_function(&SolverDDP::get_cost_lower_bound,
+                                      bp::return_value_policy<bp::copy_const_reference>()),
+                    &SolverDDP::set_cost_lower_bound,
+                    "lower bound of the cost of each node (-inf by default).\n\n"
+                    "With a finite bound (e.g. 0 for non-negative costs), the line search stops the rollouts\n"
+                    "as soon as they cannot pass the acceptance test.");
 }
 
 }  // namespace python
@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BINDINGS_PYTHON_CROCODDYL_CORE_SOLVERS_FDDP_HPP_
+#define BINDINGS_PYTHON_CROCODDYL_CORE_SOLVERS_FDDP_HPP_
+
+#include "crocoddyl/core/solvers/fddp.hpp"
+
+namespace crocoddyl {
+namespace python {
+
+namespace bp = boost::python;
+
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(SolverFDDP_solves, SolverDDP::solve, 0, 5)
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(SolverFDDP_forwardPasses, SolverDDP::forwardPass, 1, 2)
+
+void exposeSolverFDDP() {
+  bp::class_<SolverFDDP, bp::bases<SolverDDP> >(
+      "SolverFDDP",
+      "Feasibility-driven DDP (FDDP) solver.\n\n"
+      "The FDDP solver computes an optimal trajectory and control commands by iterates\n"
+      "running backward and forward passes. The backward-pass updates locally the\n"
+      "quadratic approximation of the problem and computes descent direction,\n"
+      "and the forward-pass rollouts this new policy by integrating the system dynamics\n"
+      "along a tuple of optimized control commands U*.\n"
+      "The solver is particularly interesting when providing an unfeasible guess (i.e. xs\n"
+      "is not the rollout of us). In that case the solver does not try to immediately compute\n"
+      "a feasible candidate, but rather maintains the gaps at the shooting nodes and closes\n"
+      "them progressively while it is searching for a good optimization.\n"
+      ":param shootingProblem: shooting problem (list of action models along trajectory.)",
+      bp::init<ShootingProblem&>(bp::args(" self", " problem"),
+                                 "Initialize the vector dimension.\n\n"
+                                 ":param problem: shooting problem.")[bp::with_custodian_and_ward<1, 2>()])
+      .def("solve", &SolverDDP::solve,
+           SolverFDDP_solves(
+               bp::args(" self", " init_xs=[]", " init_us=[]", " maxiter=100", " isFeasible=False", " regInit=None"),
+               "Compute the optimal trajectory xopt, uopt as lists of T+1 and T terms.\n\n"
+               "From an initial guess init_xs,init_us (feasible or not), iterate\n"
+               "over computeDirection and tryStep until stoppingCriteria is below\n"
+               "threshold. It also describes the globalization strategy used\n"
+               "during the numerical optimization.\n"
+               ":param init_xs: initial guess for state trajectory with T+1 elements.\n"
+               ":param init_us: initial guess for control trajectory with T elements.\n"
+               ":param maxiter: maximun allowed number of iterations.\n"
+               ":param isFeasible: true if the init_xs are obtained from integrating the init_us (rollout).\n"
+               ":param regInit: initial guess for the regularization value. Very low values are typical\n"
+               "                used with very good guess points (init_xs, init_us).\n"
+               ":returns the optimal trajectory xopt, uopt and a boolean that describes if convergence was reached."))
+      .def("updateExpectedImprovement", &SolverFDDP::updateExpectedImprovement, bp::args(" self"),
+           "Update the expected improvement model\n\n"
+           "The terms computed here don't depend on the step length, only on the search\n"
+           "direction. So you need to run it only once after computeDirection.")
+      .def("expectedImprovement", &SolverFDDP::expectedImprovement,
+           bp::return_value_policy<bp::copy_const_reference>(), bp::args(" self"),
+           "Return two scalars denoting the quadratic improvement model\n\n"
+           "For computing the expected improvement, you need to compute first\n"
+           "the search direction by running computeDirection and updateExpectedImprovement,\n"
+           "and then the rollout by running tryStep. The quadratic improvement model is\n"
+           "described as dV = f_0 - f_+ = d1*a + d2*a**2/2.")
+      .def("calc", &SolverFDDP::calc, bp::args(" self"),
+           "Update the Jacobian and Hessian of the optimal control problem\n\n"
+           "These derivatives are computed around the guess state and control\n"
+           "trajectory. These trajectory can be set by using setCandidate.\n"
+           ":return the total cost around the guess trajectory.")
+      .def("backwardPass", &SolverFDDP::backwardPass, bp::args(" self"),
+           "Run the backward pass (Riccati sweep)\n\n"
+           "It assumes that the Jacobian and Hessians of the optimal control problem have been\n"
+           "compute. These terms are computed by running calc. The gradient of the value\n"
+           "function (Vx) is computed at the end of each interval (i.e. at the rollout state).\n"
+           ":returns the status of the sweep (the failed node is given by failedNode).")
+      .def("forwardPass", &SolverFDDP::forwardPass,
+           SolverFDDP_forwardPasses(
+               bp::args(" self", " stepLength", " costMax=inf"),
+               "Run the forward pass or rollout\n\n"
+               "It rollouts the action model give the computed policy (feedfoward terns and feedback\n"
+               "gains) by the backwardPass. The gaps are only closed with a full step, otherwise\n"
+               "they are reduced by the applied step length.\n"
+               ":param stepLength: applied step length (<= 1. and >= 0.)\n"
+               ":param costMax: cost above which the step is rejected\n"
+               ":returns the status of the rollout (the diverged node is given by failedNode)."))
+      .add_property("th_acceptNegStep",
+                    bp::make_function(&SolverFDDP::get_th_acceptnegstep,
+                                      bp::return_value_policy<bp::copy_const_reference>()),
+                    &SolverFDDP::set_th_acceptnegstep, "threshold for step acceptance in ascent direction")
+      .add_property("multipleShooting",
+                    bp::make_function(&SolverFDDP::get_multiple_shooting,
+                                      bp::return_value_policy<bp::copy_const_reference>()),
+                    &SolverFDDP::set_multiple_shooting,
+                    "true if the trial states are predicted by the linearized dynamics, and evaluated in parallel")
+      .add_property("th_gapTol",
+                    bp::make_function(&SolverFDDP::get_th_gaptol, bp::return_value_policy<bp::copy_const_reference>()),
+                    &SolverFDDP::set_th_gaptol, "largest gap of a feasible candidate in the multiple-shooting mode");
+}
+
+}  // namespace python
+}  // namespace crocoddyl
+
+#endif  // BINDINGS_PYTHON_CROCODDYL_CORE_SOLVERS_FDDP_HPP_
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BINDINGS_PYTHON_CROCODDYL_CORE_SOLVERS_KKT_HPP_
+#define BINDINGS_PYTHON_CROCODDYL_CORE_SOLVERS_KKT_HPP_
+
+#include "crocoddyl/core/solvers/kkt.hpp"
+
+namespace crocoddyl {
+namespace python {
+
+namespace bp = boost::python;
+
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(SolverKKT_solves, SolverKKT::solve, 0, 5)
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(SolverKKT_computeDirections, SolverKKT::computeDirection, 0, 1)
+BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(SolverKKT_trySteps, SolverKKT::tryStep, 0, 1)
+
+void exposeSolverKKT() {
+  bp::class_<SolverKKT, bp::bases<SolverAbstract> >(
+      "SolverKKT",
+      "KKT solver.\n\n"
+      "The KKT solver computes the Newton step of the multiple-shooting problem by solving\n"
+      "its KKT system. The KKT matrix is ordered stage-wise, so it is banded and its sparse\n"
+      "factorization has a cost and memory that grow linearly with the number of nodes.\n"
+      ":param shootingProblem: shooting problem (list of action models along trajectory.)",
+      bp::init<ShootingProblem&>(bp::args(" self", " problem"),
+                                 "Initialize the vector dimension.\n\n"
+                                 ":param problem: shooting problem.")[bp::with_custodian_and_ward<1, 2>()])
+      .def("solve", &SolverKKT::solve,
+           SolverKKT_solves(
+               bp::args(" self", " init_xs=[]", " init_us=[]", " maxiter=100", " isFeasible=False", " regInit=None"),
+               "Compute the optimal trajectory xopt, uopt as lists of T+1 and T terms.\n\n"
+               "From an initial guess init_xs,init_us (feasible or not), iterate\n"
+               "over computeDirection and tryStep until stoppingCriteria is below\n"
+               "threshold. It also describes the globalization strategy used\n"
+               "during the numerical optimization.\n"
+               ":param init_xs: initial guess for state trajectory with T+1 elements.\n"
+               ":param init_us: initial guess for control trajectory with T elements.\n"
+               ":param maxiter: maximun allowed number of iterations.\n"
+               ":param isFeasible: true if the init_xs are obtained from integrating the init_us (rollout).\n"
+               ":param regInit: regularization of the Hessian of the KKT matrix.\n"
+               ":returns the optimal trajectory xopt, uopt and a boolean that describes if convergence was reached."))
+      .def("computeDirection", &SolverKKT::computeDirection,
+           SolverKKT_computeDirections(
+               bp::args(" self", " recalc=True"),
+               "Compute the search direction (dx, du, lambda) for the current guess (xs, us).\n\n"
+               "You must call setCandidate first in order to define the current\n"
+               "guess. A current guess defines a state and control trajectory\n"
+               "(xs, us) of T+1 and T elements, respectively.\n"
+               ":params recalc: true for recalculating the derivatives at current state and control."))
+      .def("tryStep", &SolverKKT::tryStep,
+           SolverKKT_trySteps(bp::args(" self", " stepLength=1"),
+                              "Update the guess with a predefined step length.\n\n"
+                              ":param stepLength: step length\n"
+                              ":returns the cost improvement."))
+      .def("stoppingCriteria", &SolverKKT::stoppingCriteria, bp::args(" self"),
+           "Return the squared norm of the gradient of the Lagrangian and of the constraint values.")
+      .def("expectedImprovement", &SolverKKT::expectedImprovement, bp::return_value_policy<bp::copy_const_reference>(),
+           bp::args(" self"),
+           "Return two scalars denoting the quadratic improvement model\n\n"
+           "For computing the expected improvement, you need to compute first\n"
+           "the search direction by running computeDirection. The quadratic\n"
+           "improvement model is described as dV = f_0 - f_+ = d1*a + d2*a**2/2.")
+      .def("calc", &SolverKKT::calc, bp::args(" self"),
+           "Update the KKT matrix and vector of the optimal control problem\n\n"
+           "These terms are computed around the guess state and control\n"
+           "trajectory. These trajectory can be set by using setCandidate.\n"
+           ":return the total cost around the guess trajectory.")
+      .def("computePrimalDual", &SolverKKT::computePrimalDual, bp::args(" self"),
+           "Factorize the KKT matrix and compute the primal-dual step.\n\n"
+           ":returns the status of the factorization.")
+      .add_property("kktref",
+                    make_function(&SolverKKT::get_kktref, bp::return_value_policy<bp::copy_const_reference>()),
+                    "KKT vector, i.e. cost gradient and constraint values")
+      .add_property("primaldual",
+                    make_function(&SolverKKT::get_primaldual, bp::return_value_policy<bp::copy_const_reference>()),
+                    "primal-dual step")
+      .add_property("dxs", make_function(&SolverKKT::get_dxs, bp::return_value_policy<bp::copy_const_reference>()),
+                    "state steps")
+      .add_property("dus", make_function(&SolverKKT::get_dus, bp::return_value_policy<bp::copy_const_reference>()),
+                    "control steps")
+      .add_property("lambdas",
+                    make_function(&SolverKKT::get_lambdas, bp::return_value_policy<bp::copy_const_reference>()),
+                    "Lagrange multipliers of the dynamics constraints")
+      .add_property("nx", make_function(&SolverKKT::get_nx, bp::return_value_policy<bp::copy_const_reference>()),
+                    "total dimension of the states")
+      .add_property("ndx", make_function(&SolverKKT::get_ndx, bp::return_value_policy<bp::copy_const_reference>()),
+                    "total dimension of the state tangent spaces")
+      .add_property("nu", make_function(&SolverKKT::get_nu, bp::return_value_policy<bp::copy_const_reference>()),
+                    "total dimension of the controls");
+}
+
+}  // namespace python
+}  // namespace crocoddyl
+
+#endif  // BINDINGS_PYTHON_CROCODDYL_CORE_SOLVERS_KKT_HPP_
@@ -9,7 +9,9 @@
 #ifndef BINDINGS_PYTHON_CROCODDYL_CORE_UTILS_CALLBACKS_HPP_
 #define BINDINGS_PYTHON_CROCODDYL_CORE_UTILS_CALLBACKS_HPP_
 
+#include <vector>
 #include "crocoddyl/core/utils/callbacks.hpp"
+#include "python/crocoddyl/utils.hpp"
 
 namespace crocoddyl {
 namespace python {
@@ -27,6 +29,50 @@ void exposeCallbacks() {
       .def("__call__", &CallbackVerbose::operator(), bp::args(" self", " solver"),
            "Run the callback function given a solver.\n\n"
            ":param solver: solver to be diagnostic");
+
+  // Register custom converters between std::vector and Python list
+  bp::to_python_converter<std::vector<IterationCallbackAbstract*, std::allocator<IterationCallbackAbstract*> >,
+                          vector_to_list<IterationCallbackAbstract*> >();
+  list_to_vector().from_python<std::vector<IterationCallbackAbstract*, std::allocator<IterationCallbackAbstract*> > >();
+
+  bp::class_<IterationCallbackAbstract, boost::noncopyable>(
+      "IterationCallbackAbstract",
+      "Abstract class for the callbacks run by CallbackAsync.\n\n"
+      "They receive a record of the iteration values instead of the solver.",
+      bp::no_init);
+
+  bp::class_<IterationCallbackVerbose, bp::bases<IterationCallbackAbstract>, boost::noncopyable>(
+      "IterationCallbackVerbose", "Callback function for printing the iteration values from CallbackAsync.",
+      bp::init<bp::optional<VerboseLevel> >(bp::args(" self", " level=_1"),
+                                            "Initialize the verbose callback.\n\n"
+                                            ":param level: verbose level"));
+
+#ifdef CROCODDYL_WITH_ASYNC_CALLBACKS
+  bp::class_<CallbackAsync, bp::bases<CallbackAbstract>, boost::noncopyable>(
+      "CallbackAsync",
+      "Callback function that runs other callbacks on a background thread.\n\n"
+      "The solver only queues a fixed-size record of each iteration in a ring, and the\n"
+      "records that don't fit in the ring are dropped. The solve waits at its end until\n"
+      "the callbacks have run on all the queued records.",
+      bp::init<bp::optional<std::size_t> >(bp::args(" self", " capacity=64"),
+                                           "Initialize the asynchronous callback.\n\n"
+                                           ":param capacity: number of records kept in the ring"))
+      .def("__call__", &CallbackAsync::operator(), bp::args(" self", " solver"),
+           "Queue the record of the current iteration of a solver.\n\n"
+           ":param solver: solver to be diagnostic")
+      .def("flush", &CallbackAsync::flush, bp::args(" self"),
+           "Wait until the callbacks have run on all the queued records.")
+      .def("setCallbacks", &CallbackAsync::setCallbacks, bp::args(" self", " callbacks"),
+           "Set the callbacks run on the background thread.\n\n"
+           ":param callbacks: list of IterationCallbackAbstract")
+      .add_property("capacity", bp::make_function(&CallbackAsync::get_capacity,
+                                                  bp::return_value_policy<bp::copy_const_reference>()),
+                    "number of records kept in the ring")
+      .add_property("dropped", bp::make_function(&CallbackAsync::get_dropped,
+                                                 bp::return_value_policy<bp::copy_const_reference>()),
+                    "number of records dropped because the ring was full")
+      .add_property("dispatched", &CallbackAsync::get_dispatched, "number of records on which the callbacks have run");
+#endif
 }
 
 }  // namespace python
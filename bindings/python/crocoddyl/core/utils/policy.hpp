@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BINDINGS_PYTHON_CROCODDYL_CORE_UTILS_POLICY_HPP_
+#define BINDINGS_PYTHON_CROCODDYL_CORE_UTILS_POLICY_HPP_
+
+#include "crocoddyl/core/utils/policy.hpp"
+
+namespace crocoddyl {
+namespace python {
+
+namespace bp = boost::python;
+
+bp::list PolicySnapshot_ts(const PolicySnapshot& self) {
+  bp::list ts;
+  for (std::size_t t = 0; t < self.ts.size(); ++t) {
+    ts.append(self.ts[t]);
+  }
+  return ts;
+}
+
+Eigen::VectorXd PolicyEvaluator_evaluate(PolicyEvaluator& self, const PolicySnapshot& policy, const double& time,
+                                         const Eigen::VectorXd& x) {
+  Eigen::VectorXd u(policy.us[0].size());
+  self.evaluate(policy, time, x, u);
+  return u;
+}
+
+void exposePolicy() {
+  bp::class_<PolicySnapshot>("PolicySnapshot",
+                             "Feedback policy of a solver, i.e. u = us[t] - K[t] * diff(xs[t], x) around the node t.",
+                             bp::no_init)
+      .add_property("xs", bp::make_getter(&PolicySnapshot::xs, bp::return_value_policy<bp::return_by_value>()),
+                    "state trajectory")
+      .add_property("us", bp::make_getter(&PolicySnapshot::us, bp::return_value_policy<bp::return_by_value>()),
+                    "control sequence")
+      .add_property("K", bp::make_getter(&PolicySnapshot::K, bp::return_value_policy<bp::return_by_value>()),
+                    "feedback gains")
+      .add_property("ts", &PolicySnapshot_ts, "time of each node")
+      .def_readonly("cost", &PolicySnapshot::cost, "cost of the policy")
+      .def_readonly("iter", &PolicySnapshot::iter, "iteration of the solver that computed the policy")
+      .def_readonly("sequence", &PolicySnapshot::sequence,
+                    "number of the publication, 0 if nothing was published yet");
+
+  bp::class_<PolicyPublisher, bp::bases<CallbackAbstract>, boost::noncopyable>(
+      "PolicyPublisher",
+      "Hand off the feedback policy of a DDP solver to another thread.\n\n"
+      "As a callback, it publishes the policy after each iteration that accepted a step.\n"
+      "It uses three buffers, so the solver and the reader thread never wait for each other.",
+      bp::init<SolverDDP&, double>(bp::args(" self", " solver", " dt"),
+                                   "Initialize the publisher of a solver.\n\n"
+                                   ":param solver: DDP solver\n"
+                                   ":param dt: time between the nodes")[bp::with_custodian_and_ward<1, 2>()])
+      .def("__call__", &PolicyPublisher::operator(), bp::args(" self", " solver"),
+           "Publish the policy if the last iteration accepted a step.\n\n"
+           ":param solver: solver of the publisher")
+      .def("publish", &PolicyPublisher::publish, bp::args(" self"), "Publish the current policy of the solver.")
+      .def("read", &PolicyPublisher::read, bp::return_internal_reference<>(), bp::args(" self"),
+           "Return the last published policy.\n\n"
+           "The returned policy is not modified until the next call of read.")
+      .def("hasUpdate", &PolicyPublisher::has_update, bp::args(" self"),
+           "Return true if a policy was published after the last read.")
+      .add_property("time",
+                    bp::make_function(&PolicyPublisher::get_time, bp::return_value_policy<bp::copy_const_reference>()),
+                    &PolicyPublisher::set_time, "time of the initial state of the problem")
+      .add_property("dt",
+                    bp::make_function(&PolicyPublisher::get_dt, bp::return_value_policy<bp::copy_const_reference>()),
+                    &PolicyPublisher::set_dt, "time between the nodes");
+
+  bp::class_<PolicyEvaluator, boost::noncopyable>(
+      "PolicyEvaluator",
+      "Evaluate a policy at a given time and state.\n\n"
+      "The controls are linearly interpolated between the two nodes around the given time.",
+      bp::init<ShootingProblem&>(bp::args(" self", " problem"),
+                                 "Initialize the evaluator.\n\n"
+                                 ":param problem: shooting problem of the policy")[bp::with_custodian_and_ward<1, 2>()])
+      .def("evaluate", &PolicyEvaluator_evaluate, bp::args(" self", " policy", " time", " x"),
+           "Compute the control of the policy.\n\n"
+           ":param policy: policy snapshot\n"
+           ":param time: current time\n"
+           ":param x: current state\n"
+           ":returns the control");
+}
+
+}  // namespace python
+}  // namespace crocoddyl
+
+#endif  // BINDINGS_PYTHON_CROCODDYL_CORE_UTILS_POLICY_HPP_
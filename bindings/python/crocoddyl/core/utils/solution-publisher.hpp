@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BINDINGS_PYTHON_CROCODDYL_CORE_UTILS_SOLUTION_PUBLISHER_HPP_
+#define BINDINGS_PYTHON_CROCODDYL_CORE_UTILS_SOLUTION_PUBLISHER_HPP_
+
+#include "crocoddyl/core/utils/solution-publisher.hpp"
+
+namespace crocoddyl {
+namespace python {
+
+namespace bp = boost::python;
+
+bp::object SolutionReader_read(const SolutionReader& self, const boost::uint64_t& index) {
+  SolutionStats stats;
+  Eigen::VectorXd xs, us;
+  if (!self.read(index, stats, xs, us)) {
+    return bp::object();
+  }
+  return bp::make_tuple(stats, xs, us);
+}
+
+bp::object SolutionReader_readLast(const SolutionReader& self) {
+  SolutionStats stats;
+  Eigen::VectorXd xs, us;
+  if (!self.read_last(stats, xs, us)) {
+    return bp::object();
+  }
+  return bp::make_tuple(stats, xs, us);
+}
+
+void exposeSolutionPublisher() {
+  bp::class_<SolutionStats>("SolutionStats", "Iteration stats of a published solution.")
+      .def_readonly("index", &SolutionStats::index, "number of the publication")
+      .def_readonly("cost", &SolutionStats::cost, "total cost")
+      .def_readonly("stop", &SolutionStats::stop, "stopping criteria")
+      .def_readonly("xreg", &SolutionStats::xreg, "state regularization")
+      .def_readonly("ureg", &SolutionStats::ureg, "control regularization")
+      .def_readonly("stepLength", &SolutionStats::steplength, "accepted step length")
+      .def_readonly("dV", &SolutionStats::dV, "cost reduction")
+      .def_readonly("dVexp", &SolutionStats::dVexp, "expected cost reduction")
+      .def_readonly("iter", &SolutionStats::iter, "iteration of the solver")
+      .def_readonly("isFeasible", &SolutionStats::feasible, "1 if the solution is feasible");
+
+  bp::class_<SolutionPublisher, bp::bases<CallbackAbstract>, boost::noncopyable>(
+      "SolutionPublisher",
+      "Publish the accepted solutions of a solver in a POSIX shared-memory ring.\n\n"
+      "As a callback, it copies the candidate and iteration stats after each iteration that\n"
+      "accepted a step. Each slot of the ring is protected by a seqlock, so the solver never\n"
+      "waits for the readers. The shared memory is removed with the publisher.",
+      bp::init<std::string, ShootingProblem&, bp::optional<std::size_t> >(
+          bp::args(" self", " name", " problem", " capacity=16"),
+          "Create the shared-memory ring.\n\n"
+          ":param name: name of the shared memory (e.g. /crocoddyl)\n"
+          ":param problem: shooting problem of the solutions\n"
+          ":param capacity: number of solutions kept in the ring"))
+      .def("__call__", &SolutionPublisher::operator(), bp::args(" self", " solver"),
+           "Publish the solution if the last iteration accepted a step.\n\n"
+           ":param solver: solver to be published")
+      .def("publish", &SolutionPublisher::publish, bp::args(" self", " solver"),
+           "Publish the current solution of a solver.\n\n"
+           ":param solver: solver to be published")
+      .add_property("isOpen", &SolutionPublisher::is_open, "true if the shared memory was created")
+      .add_property("published", &SolutionPublisher::get_published, "number of published solutions");
+
+  bp::class_<SolutionReader, boost::noncopyable>(
+      "SolutionReader",
+      "Read the solutions of a SolutionPublisher, e.g. from another process.\n\n"
+      "The solution (xs, us) are the states and controls of the nodes stacked.",
+      bp::init<std::string>(bp::args(" self", " name"),
+                            "Map the shared-memory ring.\n\n"
+                            ":param name: name of the shared memory"))
+      .def("read", &SolutionReader_read, bp::args(" self", " index"),
+           "Return the published solution (stats, xs, us) of a given index.\n\n"
+           ":param index: number of the publication\n"
+           ":returns None if it was overwritten or not yet published")
+      .def("readLast", &SolutionReader_readLast, bp::args(" self"),
+           "Return the last published solution (stats, xs, us), or None if there is none.")
+      .add_property("isOpen", &SolutionReader::is_open, "true if the shared memory was mapped")
+      .add_property("published", &SolutionReader::get_published, "number of published solutions")
+      .add_property("T", &SolutionReader::get_T, "number of running nodes")
+      .add_property("nxs", &SolutionReader::get_nxs, "dimension of the stacked states")
+      .add_property("nus", &SolutionReader::get_nus, "dimension of the stacked controls")
+      .add_property("capacity", &SolutionReader::get_capacity, "number of solutions kept in the ring");
+}
+
+}  // namespace python
+}  // namespace crocoddyl
+
+#endif  // BINDINGS_PYTHON_CROCODDYL_CORE_UTILS_SOLUTION_PUBLISHER_HPP_
@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BINDINGS_PYTHON_CROCODDYL_CORE_UTILS_TRACE_HPP_
+#define BINDINGS_PYTHON_CROCODDYL_CORE_UTILS_TRACE_HPP_
+
+#include "crocoddyl/core/utils/trace.hpp"
+
+namespace crocoddyl {
+namespace python {
+
+namespace bp = boost::python;
+
+void exposeTrace() {
+  void (TraceRecorder::*dump)(const std::string&) const = &TraceRecorder::dump;
+
+  bp::class_<TraceRecorder, boost::noncopyable>(
+      "TraceRecorder",
+      "Recorder of the model evaluations in the Chrome trace format.\n\n"
+      "It records the calc and calcDiff of each node, cost item and contact item, if the library\n"
+      "was built with BUILD_WITH_TRACE. The trace file can be opened in chrome://tracing or Perfetto.",
+      bp::no_init)
+      .def("clear", &TraceRecorder::clear, bp::args(" self"), "Remove the recorded events.")
+      .def("dump", dump, bp::args(" self", " filename"),
+           "Write the recorded events as a Chrome trace JSON.\n\n"
+           ":param filename: path of the trace file")
+      .add_property("enabled",
+                    bp::make_function(&TraceRecorder::get_enabled,
+                                      bp::return_value_policy<bp::copy_const_reference>()),
+                    &TraceRecorder::set_enabled, "true if the events are recorded")
+      .add_property("capacity", &TraceRecorder::get_capacity, &TraceRecorder::set_capacity,
+                    "maximum number of recorded events (setting it clears the events)")
+      .add_property("size", &TraceRecorder::get_size, "number of recorded events")
+      .add_property("dropped", &TraceRecorder::get_dropped, "number of events dropped once the buffer was full");
+
+  bp::def("getTraceRecorder", &TraceRecorder::get_instance, bp::return_value_policy<bp::reference_existing_object>(),
+          "Return the trace recorder used by the library.");
+}
+
+}  // namespace python
+}  // namespace crocoddyl
+
+#endif  // BINDINGS_PYTHON_CROCODDYL_CORE_UTILS_TRACE_HPP_
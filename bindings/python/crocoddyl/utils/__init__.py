@@ -799,3 +799,182 @@ class DDPDerived(crocoddyl.SolverAbstract):
         raiseIfNan(ctry, ArithmeticError('forward error'))
         self.cost_try = ctry
         return xtry, utry, ctry
+
+
+class FDDPDerived(DDPDerived):
+    def __init__(self, shootingProblem):
+        DDPDerived.__init__(self, shootingProblem)
+
+        self.th_acceptNegStep = 2.
+        self.dg = 0.
+        self.dq = 0.
+        self.dv = 0.
+
+    def calc(self):
+        self.cost = self.problem.calcDiff(self.xs, self.us)
+        if not self.isFeasible:
+            # Gap store the state defect from the guess to feasible (rollout) trajectory, i.e.
+            #   gap = x_rollout [-] x_guess = DIFF(x_guess, x_rollout)
+            self.gaps[0] = self.problem.runningModels[0].state.diff(self.xs[0], self.problem.x0)
+            for i, (m, d, x) in enumerate(zip(self.problem.runningModels, self.problem.runningDatas, self.xs[1:])):
+                self.gaps[i + 1] = m.state.diff(x, d.xnext)
+        elif not self.wasFeasible:
+            self.gaps[:] = [np.zeros_like(f) for f in self.gaps]
+        return self.cost
+
+    def updateExpectedImprovement(self):
+        self.dg = 0.
+        self.dq = 0.
+        if not self.isFeasible:
+            self.dg -= np.asscalar(self.Vx[-1].T * self.gaps[-1])
+            self.dq += np.asscalar(self.gaps[-1].T * self.Vxx[-1] * self.gaps[-1])
+        for t in range(self.problem.T):
+            self.dg += np.asscalar(self.Qu[t].T * self.k[t])
+            self.dq -= np.asscalar(self.k[t].T * self.Quu[t] * self.k[t])
+            if not self.isFeasible:
+                self.dg -= np.asscalar(self.Vx[t].T * self.gaps[t])
+                self.dq += np.asscalar(self.gaps[t].T * self.Vxx[t] * self.gaps[t])
+
+    def expectedImprovement(self):
+        self.dv = 0.
+        if not self.isFeasible:
+            for t in range(self.problem.T):
+                dx = self.problem.runningModels[t].state.diff(self.xs_try[t], self.xs[t])
+                self.dv -= np.asscalar(self.gaps[t].T * self.Vxx[t] * dx)
+            dx = self.problem.terminalModel.state.diff(self.xs_try[-1], self.xs[-1])
+            self.dv -= np.asscalar(self.gaps[-1].T * self.Vxx[-1] * dx)
+        d1 = self.dg + self.dv
+        d2 = self.dq - 2 * self.dv
+        return np.matrix([d1, d2]).T
+
+    def solve(self, init_xs=[], init_us=[], maxiter=100, isFeasible=False, regInit=None):
+        self.setCandidate(init_xs, init_us, isFeasible)
+        self.x_reg = regInit if regInit is not None else self.regMin
+        self.u_reg = regInit if regInit is not None else self.regMin
+        self.wasFeasible = False
+        for i in range(maxiter):
+            recalc = True
+            while True:
+                try:
+                    self.computeDirection(recalc=recalc)
+                except ArithmeticError:
+                    recalc = False
+                    self.increaseRegularization()
+                    if self.x_reg == self.regMax:
+                        return self.xs, self.us, False
+                    else:
+                        continue
+                break
+            self.updateExpectedImprovement()
+
+            for a in self.alphas:
+                try:
+                    self.dV = self.tryStep(a)
+                except ArithmeticError:
+                    continue
+                d = self.expectedImprovement()
+                d1, d2 = np.asscalar(d[0]), np.asscalar(d[1])
+
+                self.dV_exp = a * (d1 + .5 * d2 * a)
+                if self.dV_exp >= 0:  # descend direction
+                    if d1 < self.th_grad or self.dV > self.th_acceptStep * self.dV_exp:
+                        # Accept step
+                        self.wasFeasible = self.isFeasible
+                        self.setCandidate(self.xs_try, self.us_try, (self.wasFeasible or a == 1))
+                        self.cost = self.cost_try
+                        break
+                else:  # reducing the gaps by allowing a small increment in the cost value
+                    if self.dV > self.th_acceptNegStep * self.dV_exp:
+                        # Accept step
+                        self.wasFeasible = self.isFeasible
+                        self.setCandidate(self.xs_try, self.us_try, (self.wasFeasible or a == 1))
+                        self.cost = self.cost_try
+                        break
+            if a > self.th_step:
+                self.decreaseRegularization()
+            if a == self.alphas[-1]:
+                self.increaseRegularization()
+                if self.x_reg == self.regMax:
+                    return self.xs, self.us, False
+            self.stepLength = a
+            self.iter = i
+            self.stop = self.stoppingCriteria()
+
+            if self.wasFeasible and self.stop < self.th_stop:
+                return self.xs, self.us, True
+
+        # Warning: no convergence in max iterations
+        return self.xs, self.us, False
+
+    def backwardPass(self):
+        self.Vx[-1][:] = self.problem.terminalData.Lx
+        self.Vxx[-1][:, :] = self.problem.terminalData.Lxx
+
+        if self.x_reg != 0:
+            ndx = self.problem.terminalModel.state.ndx
+            self.Vxx[-1][range(ndx), range(ndx)] += self.x_reg
+
+        # Compute and store the Vx gradient at end of the interval (rollout state)
+        if not self.isFeasible:
+            self.Vx[-1] += self.Vxx[-1] * self.gaps[-1]
+
+        for t, (model, data) in rev_enumerate(zip(self.problem.runningModels, self.problem.runningDatas)):
+            self.Qxx[t][:, :] = data.Lxx + data.Fx.T * self.Vxx[t + 1] * data.Fx
+            self.Qxu[t][:, :] = data.Lxu + data.Fx.T * self.Vxx[t + 1] * data.Fu
+            self.Quu[t][:, :] = data.Luu + data.Fu.T * self.Vxx[t + 1] * data.Fu
+            self.Qx[t][:] = data.Lx + data.Fx.T * self.Vx[t + 1]
+            self.Qu[t][:] = data.Lu + data.Fu.T * self.Vx[t + 1]
+
+            if self.u_reg != 0:
+                self.Quu[t][range(model.nu), range(model.nu)] += self.u_reg
+
+            self.computeGains(t)
+
+            if self.u_reg == 0:
+                self.Vx[t][:] = self.Qx[t] - self.K[t].T * self.Qu[t]
+            else:
+                self.Vx[t][:] = self.Qx[t] - 2 * self.K[t].T * self.Qu[t] + self.K[t].T * self.Quu[t] * self.k[t]
+            self.Vxx[t][:, :] = self.Qxx[t] - self.Qxu[t] * self.K[t]
+            self.Vxx[t][:, :] = 0.5 * (self.Vxx[t][:, :] + self.Vxx[t][:, :].T)  # ensure symmetric
+
+            if self.x_reg != 0:
+                self.Vxx[t][range(model.state.ndx), range(model.state.ndx)] += self.x_reg
+
+            # Compute and store the Vx gradient at end of the interval (rollout state)
+            if not self.isFeasible:
+                self.Vx[t] += self.Vxx[t] * self.gaps[t]
+
+            raiseIfNan(self.Vxx[t], ArithmeticError('backward error'))
+            raiseIfNan(self.Vx[t], ArithmeticError('backward error'))
+
+    def forwardPass(self, stepLength, warning='ignore'):
+        # Argument warning is also introduce for debug: by default, it masks the numpy warnings
+        #    that can be reactivated during debug.
+        xs, us = self.xs, self.us
+        xtry, utry = self.xs_try, self.us_try
+        ctry = 0
+        xnext = self.problem.x0
+        for t, (m, d) in enumerate(zip(self.problem.runningModels, self.problem.runningDatas)):
+            if self.isFeasible or stepLength == 1:
+                xtry[t] = xnext.copy()
+            else:
+                xtry[t] = m.state.integrate(xnext, self.gaps[t] * (stepLength - 1))
+            utry[t] = us[t] - self.k[t] * stepLength - np.dot(self.K[t], m.state.diff(xs[t], xtry[t]))
+            with np.warnings.catch_warnings():
+                np.warnings.simplefilter(warning)
+                m.calc(d, xtry[t], utry[t])
+                xnext, cost = d.xnext, d.cost
+            ctry += cost
+            raiseIfNan([ctry, cost], ArithmeticError('forward error'))
+            raiseIfNan(xnext, ArithmeticError('forward error'))
+        if self.isFeasible or stepLength == 1:
+            xtry[-1] = xnext.copy()
+        else:
+            xtry[-1] = self.problem.terminalModel.state.integrate(xnext, self.gaps[-1] * (stepLength - 1))
+        with np.warnings.catch_warnings():
+            np.warnings.simplefilter(warning)
+            self.problem.terminalModel.calc(self.problem.terminalData, xtry[-1])
+            ctry += self.problem.terminalData.cost
+        raiseIfNan(ctry, ArithmeticError('forward error'))
+        self.cost_try = ctry
+        return xtry, utry, ctry
@@ -30,7 +30,8 @@ class ActionModelAbstract {
   virtual boost::shared_ptr<ActionDataAbstract> createData();
 
   void calc(const boost::shared_ptr<ActionDataAbstract>& data, const Eigen::Ref<const Eigen::VectorXd>& x);
-  void calcDiff(const boost::shared_ptr<ActionDataAbstract>& data, const Eigen::Ref<const Eigen::VectorXd>& x);
+  void calcDiff(const boost::shared_ptr<ActionDataAbstract>& data, const Eigen::Ref<const Eigen::VectorXd>& x,
+                const bool& recalc = true);
 
   void quasicStatic(const boost::shared_ptr<ActionDataAbstract>& data, Eigen::Ref<Eigen::VectorXd> u,
                     const Eigen::Ref<const Eigen::VectorXd>& x, unsigned int const& maxiter = 100,
@@ -98,7 +99,12 @@ struct ActionDataAbstract {
         Lu(model->get_nu()),
         Lxx(model->get_state().get_ndx(), model->get_state().get_ndx()),
         Lxu(model->get_state().get_ndx(), model->get_nu()),
-        Luu(model->get_nu(), model->get_nu()) {
+        Luu(model->get_nu(), model->get_nu()),
+        Fu_svd(model->get_state().get_ndx(), model->get_nu(), Eigen::ComputeFullU | Eigen::ComputeFullV),
+        qs_dx(model->get_state().get_ndx()),
+        qs_du(model->get_nu()),
+        qs_Fxdx(model->get_state().get_ndx()),
+        qs_y(std::min(model->get_state().get_ndx(), model->get_nu())) {
     xnext.setZero();
     r.setZero();
     Fx.setZero();
@@ -108,6 +114,10 @@ struct ActionDataAbstract {
     Lxx.setZero();
     Lxu.setZero();
     Luu.setZero();
+    qs_dx.setZero();
+    qs_du.setZero();
+    qs_Fxdx.setZero();
+    qs_y.setZero();
   }
 
   const double& get_cost() const { return cost; }
@@ -131,6 +141,15 @@ struct ActionDataAbstract {
   Eigen::MatrixXd Lxx;
   Eigen::MatrixXd Lxu;
   Eigen::MatrixXd Luu;
+
+  // Workspace of ActionModelAbstract::quasicStatic. Fu isn't square, so the SVD is preconditioned by a QR
+  // decomposition; the fully pivoted one is the most robust, and it is the only one whose triangular products don't
+  // trip GCC's -Wmaybe-uninitialized (it requires the full U and V)
+  Eigen::JacobiSVD<Eigen::MatrixXd, Eigen::FullPivHouseholderQRPreconditioner> Fu_svd;
+  Eigen::VectorXd qs_dx;
+  Eigen::VectorXd qs_du;
+  Eigen::VectorXd qs_Fxdx;
+  Eigen::VectorXd qs_y;
 };
 
 }  // namespace crocoddyl
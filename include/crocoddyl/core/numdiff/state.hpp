@@ -9,10 +9,20 @@
 #ifndef CROCODDYL_CORE_NUMDIFF_STATE_HPP_
 #define CROCODDYL_CORE_NUMDIFF_STATE_HPP_
 
+#include <boost/shared_ptr.hpp>
 #include "crocoddyl/core/state-base.hpp"
 
 namespace crocoddyl {
 
+struct StateDataNumDiff;
+
+/**
+ * @brief Numerical differentiation of a state.
+ *
+ * The workspace of the finite differences is given by the caller (see createData), so Jdiff and Jintegrate don't
+ * allocate memory. The overloads without data use a workspace owned by this object, so they aren't reentrant; the
+ * threads that share this object must call the overloads with their own data.
+ */
 class StateNumDiff : public StateAbstract {
  public:
   explicit StateNumDiff(StateAbstract& state);
@@ -59,6 +69,19 @@ class StateNumDiff : public StateAbstract {
   void Jintegrate(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& dx,
                   Eigen::Ref<Eigen::MatrixXd> Jfirst, Eigen::Ref<Eigen::MatrixXd> Jsecond,
                   Jcomponent firstsecond = both);
+  /**
+   * @brief Compute the Jacobians of diff in the workspace given by the caller
+   */
+  void Jdiff(const boost::shared_ptr<StateDataNumDiff>& data, const Eigen::Ref<const Eigen::VectorXd>& x0,
+             const Eigen::Ref<const Eigen::VectorXd>& x1, Eigen::Ref<Eigen::MatrixXd> Jfirst,
+             Eigen::Ref<Eigen::MatrixXd> Jsecond, Jcomponent firstsecond = both);
+  /**
+   * @brief Compute the Jacobians of integrate in the workspace given by the caller
+   */
+  void Jintegrate(const boost::shared_ptr<StateDataNumDiff>& data, const Eigen::Ref<const Eigen::VectorXd>& x,
+                  const Eigen::Ref<const Eigen::VectorXd>& dx, Eigen::Ref<Eigen::MatrixXd> Jfirst,
+                  Eigen::Ref<Eigen::MatrixXd> Jsecond, Jcomponent firstsecond = both);
+  boost::shared_ptr<StateDataNumDiff> createData();
   const double& get_disturbance() { return disturbance_; }
 
  private:
@@ -72,30 +95,36 @@ class StateNumDiff : public StateAbstract {
    */
   double disturbance_;
   /**
-   * @brief This is the vector containing the small element during the finite
-   * differentiation and integration. This is a temporary variable but used
-   * quiet often. For sake of memory management we allocate it once in the
-   * constructor of this class.
-   */
-  Eigen::VectorXd dx_;
-  /**
-   * @brief This is the result of diff(x0, x1, dx0_) in the finite
-   * differentiation. This is the state difference around which to compute
-   * the jacobians of the finite difference.
+   * @brief Workspace of the overloads without data
    */
-  Eigen::VectorXd dx0_;
-  /**
-   * @brief This is the result of integrate(x, dx x0_) in the finite
-   * integration. This is the state around which to compute the jacobians of
-   * the finite integrate
-   */
-  Eigen::VectorXd x0_;
-  /**
-   * @brief This is the vector containing the result of an integration. This is
-   * a temporary variable but used quiet often. For sake of memory management we
-   * allocate it once in the constructor of this class.
-   */
-  Eigen::VectorXd tmp_x_;
+  boost::shared_ptr<StateDataNumDiff> data_;
+};
+
+struct StateDataNumDiff {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  template <typename Model>
+  explicit StateDataNumDiff(Model* const state)
+      : dx(state->get_ndx()),
+        dx0(state->get_ndx()),
+        x0(state->get_nx()),
+        tmp_x(state->get_nx()),
+        tmp_x0(state->get_nx()),
+        tmp_dx(state->get_ndx()) {
+    dx.setZero();
+    dx0.setZero();
+    x0.setZero();
+    tmp_x.setZero();
+    tmp_x0.setZero();
+    tmp_dx.setZero();
+  }
+
+  Eigen::VectorXd dx;      //!< disturbance vector
+  Eigen::VectorXd dx0;     //!< state difference around which the Jacobians of diff are computed
+  Eigen::VectorXd x0;      //!< state around which the Jacobians of integrate are computed
+  Eigen::VectorXd tmp_x;   //!< disturbed state
+  Eigen::VectorXd tmp_x0;  //!< disturbed state, integrated
+  Eigen::VectorXd tmp_dx;  //!< disturbed tangent vector
 };
 
 }  // namespace crocoddyl
@@ -23,12 +23,47 @@ class ShootingProblem {
   ~ShootingProblem();
 
   double calc(const std::vector<Eigen::VectorXd>& xs, const std::vector<Eigen::VectorXd>& us);
-  double calcDiff(const std::vector<Eigen::VectorXd>& xs, const std::vector<Eigen::VectorXd>& us);
+  /**
+   * @brief Compute the derivatives of the nodes
+   *
+   * If a relinearization tolerance is set, the derivatives of a node are reused when its state and control are within
+   * the tolerance (infinity norm) of the point of its last linearization, and its model and data are the same ones.
+   * calc is still run on the reused nodes if recalc is true.
+   */
+  double calcDiff(const std::vector<Eigen::VectorXd>& xs, const std::vector<Eigen::VectorXd>& us,
+                  const bool& recalc = true);
   void rollout(const std::vector<Eigen::VectorXd>& us, std::vector<Eigen::VectorXd>& xs);
   std::vector<Eigen::VectorXd> rollout_us(const std::vector<Eigen::VectorXd>& us);
+  /**
+   * @brief Shift the horizon by one node, i.e. it drops the first node and appends (model, data) as last node
+   *
+   * The nodes are rotated in place, so it doesn't allocate memory. For recycling the first node as last node (e.g.
+   * periodic motions or models whose reference is updated by the user), pass the first model and data.
+   */
+  void circularAppend(ActionModelAbstract* model, const boost::shared_ptr<ActionDataAbstract>& data);
+  /**
+   * @brief Force the next calcDiff to evaluate the derivatives of a node (T for the terminal node)
+   *
+   * It has to be called when the parameters of the node's model are changed (e.g. its cost reference), since the
+   * problem cannot detect it.
+   */
+  void invalidateLinearization(const unsigned int& i);
+  void invalidateLinearizations();
 
   unsigned int get_T() const;
   const Eigen::VectorXd& get_x0() const;
+  void set_x0(const Eigen::VectorXd& x0);
+  const unsigned int& get_nthreads() const;
+  void set_nthreads(const unsigned int& nthreads);
+  /**
+   * @brief Return the tolerance for reusing the derivatives of a node, NaN if they are always evaluated (default)
+   */
+  const double& get_relinearization_tolerance() const;
+  void set_relinearization_tolerance(const double& tol);
+  /**
+   * @brief Return the number of nodes whose derivatives were reused by the last calcDiff
+   */
+  const unsigned int& get_nreused() const;
 
   std::vector<ActionModelAbstract*>& get_runningModels();
   ActionModelAbstract* get_terminalModel();
@@ -42,11 +77,23 @@ class ShootingProblem {
 
  protected:
   void allocateData();
+  /**
+   * @brief Return true if the derivatives of the node i are still valid at (xs[i], us[i])
+   */
+  bool isLinearizedAt(const unsigned int& i, const std::vector<Eigen::VectorXd>& xs,
+                      const std::vector<Eigen::VectorXd>& us) const;
   unsigned int T_;
   Eigen::VectorXd x0_;
+  unsigned int nthreads_;
 
  private:
   double cost_;
+  double lin_tol_;
+  unsigned int nreused_;
+  std::vector<Eigen::VectorXd> lin_xs_;  //!< linearization points, the terminal control is empty
+  std::vector<Eigen::VectorXd> lin_us_;
+  std::vector<const ActionModelAbstract*> lin_models_;
+  std::vector<const ActionDataAbstract*> lin_datas_;  //!< NULL if the node has to be linearized
 };
 
 }  // namespace crocoddyl
@@ -11,16 +11,119 @@
 
 #include <vector>
 #include "crocoddyl/core/optctrl/shooting.hpp"
+#include "crocoddyl/core/utils/timer.hpp"
 
 namespace crocoddyl {
 
 class CallbackAbstract;  // forward declaration
 static std::vector<Eigen::VectorXd> DEFAULT_VECTOR;
 
+enum SolverPhase { SolverPhaseCalc = 0, SolverPhaseCalcDiff, SolverPhaseBackwardPass, SolverPhaseForwardPass };
+
+/**
+ * @brief Outcome of the last backward (search direction) or forward (trial step) pass of a solver
+ *
+ * The passes report their failures (e.g. a NaN, a divergent rollout or a Hessian that cannot be factorized) as a
+ * status instead of throwing, so a failed pass costs the same as a successful one. The solver also records the node
+ * where the pass failed (see SolverAbstract::get_failedNode). A bounded rollout is stopped with
+ * SolverStatusStepRejected once its cost cannot pass the acceptance test anymore.
+ */
+enum SolverStatus {
+  SolverStatusSuccess = 0,
+  SolverStatusBackwardError,
+  SolverStatusForwardError,
+  SolverStatusStepRejected
+};
+
+/**
+ * @brief Wall time [ms] and number of calls of the phases of a solver
+ *
+ * calc and calcDiff are the evaluations of the problem's actions and of their derivatives, backwardPass computes the
+ * search direction (e.g. Riccati recursion) and forwardPass the line-search rollouts. A parallel line search rolls out
+ * several trials in one forward pass. The regularization retries are the search directions recomputed after a failure.
+ */
+struct SolverTimings {
+  SolverTimings() { reset(); }
+
+  void reset() {
+    calc = calcDiff = backwardPass = forwardPass = 0.;
+    ncalc = ncalcDiff = nbackwardPass = nforwardPass = 0;
+    ntrials = nregularizations = 0;
+    nlinearizations = nreuses = 0;
+  }
+
+  /**
+   * @brief Return the ratio of node derivatives that were reused instead of evaluated (see
+   * ShootingProblem::set_relinearization_tolerance)
+   */
+  double reuseRatio() const {
+    const unsigned int n = nlinearizations + nreuses;
+    return n == 0 ? 0. : static_cast<double>(nreuses) / static_cast<double>(n);
+  }
+
+  void add(const SolverPhase& phase, const double& duration) {
+    switch (phase) {
+      case SolverPhaseCalc:
+        calc += duration;
+        ++ncalc;
+        break;
+      case SolverPhaseCalcDiff:
+        calcDiff += duration;
+        ++ncalcDiff;
+        break;
+      case SolverPhaseBackwardPass:
+        backwardPass += duration;
+        ++nbackwardPass;
+        break;
+      case SolverPhaseForwardPass:
+        forwardPass += duration;
+        ++nforwardPass;
+        break;
+    }
+  }
+
+  double calc;
+  double calcDiff;
+  double backwardPass;
+  double forwardPass;
+  unsigned int ncalc;
+  unsigned int ncalcDiff;
+  unsigned int nbackwardPass;
+  unsigned int nforwardPass;
+  unsigned int ntrials;
+  unsigned int nregularizations;
+  unsigned int nlinearizations;  //!< number of nodes whose derivatives were evaluated
+  unsigned int nreuses;          //!< number of nodes whose derivatives were reused
+};
+
+/**
+ * @brief Columns of the convergence history of a solver (see SolverAbstract::get_history)
+ *
+ * The feasibility is 1 or 0, and the phase columns are the durations [ms] of the phases in the iteration.
+ */
+enum SolverHistoryField {
+  SolverHistoryCost = 0,
+  SolverHistoryStop,
+  SolverHistoryStepLength,
+  SolverHistoryXReg,
+  SolverHistoryUReg,
+  SolverHistoryDV,
+  SolverHistoryDVexp,
+  SolverHistoryFeasible,
+  SolverHistoryCalc,
+  SolverHistoryCalcDiff,
+  SolverHistoryBackwardPass,
+  SolverHistoryForwardPass,
+  SolverHistoryNbFields
+};
+
 class SolverAbstract {
  public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
+  typedef Eigen::Matrix<double, Eigen::Dynamic, SolverHistoryNbFields, Eigen::RowMajor> HistoryMatrix;
+  typedef Eigen::Map<const HistoryMatrix> HistoryMap;
+
   explicit SolverAbstract(ShootingProblem& problem);
   virtual ~SolverAbstract();
 
@@ -32,10 +135,37 @@ class SolverAbstract {
   virtual double tryStep(const double& step_length = 1) = 0;
   virtual double stoppingCriteria() = 0;
   virtual const Eigen::Vector2d& expectedImprovement() = 0;
-  void setCandidate(const std::vector<Eigen::VectorXd>& xs_warm = DEFAULT_VECTOR,
-                    const std::vector<Eigen::VectorXd>& us_warm = DEFAULT_VECTOR, const bool& is_feasible = false);
+  virtual void setCandidate(const std::vector<Eigen::VectorXd>& xs_warm = DEFAULT_VECTOR,
+                            const std::vector<Eigen::VectorXd>& us_warm = DEFAULT_VECTOR,
+                            const bool& is_feasible = false);
+  /**
+   * @brief Shift the horizon by one node for receding-horizon control
+   *
+   * It appends (model, data) as last node of the problem, and it rotates the candidate in place. The new last node is
+   * warm-started by shiftCandidate. Without arguments, the first node is recycled as last node, so there is no memory
+   * allocation. Combined with ShootingProblem::set_x0 and solve(get_xs(), get_us()), it runs an MPC cycle without
+   * rebuilding the problem or copying the warm start.
+   */
+  void shiftHorizon(ActionModelAbstract* model, const boost::shared_ptr<ActionDataAbstract>& data);
+  void shiftHorizon();
 
   void setCallbacks(const std::vector<CallbackAbstract*>& callbacks);
+  /**
+   * @brief Set the wall time [ms] given to each solve (+inf by default)
+   *
+   * The solver doesn't start an iteration or a line-search trial whose predicted duration (from the measured phase
+   * times) exceeds the remaining budget. A step is only accepted if there is time left for its search direction,
+   * so the candidate is always the last accepted iterate and the gains are always the ones of the candidate.
+   */
+  void set_time_budget(const double& budget);
+  /**
+   * @brief Set the number of iterations kept in the convergence history (256 by default)
+   *
+   * The history is allocated here and at construction only, and the iterations beyond its capacity aren't recorded.
+   * The new storage doesn't replace the one of the existing views: the maps returned by get_history are invalidated,
+   * while the owners of get_history_storage keep the previous history alive (and it isn't updated anymore).
+   */
+  void set_history_capacity(const std::size_t& capacity);
 
   const ShootingProblem& get_problem() const;
   const std::vector<ActionModelAbstract*>& get_models() const;
@@ -43,6 +173,10 @@ class SolverAbstract {
   const std::vector<Eigen::VectorXd>& get_xs() const;
   const std::vector<Eigen::VectorXd>& get_us() const;
   const bool& get_isFeasible() const;
+  /**
+   * @brief Return true if the last iteration accepted a step, i.e. if it updated the candidate
+   */
+  const bool& get_isAccepted() const;
   const unsigned int& get_iter() const;
   const double& get_cost() const;
   const double& get_stop() const;
@@ -52,15 +186,122 @@ class SolverAbstract {
   const double& get_stepLength() const;
   const double& get_dV() const;
   const double& get_dVexp() const;
+  const SolverTimings& get_timings() const;
+  const SolverTimings& get_iterTimings() const;
+  const double& get_time_budget() const;
+  /**
+   * @brief Return true if the last solve was stopped by its time budget
+   */
+  const bool& get_stoppedByBudget() const;
+  /**
+   * @brief Return the status of the last backward or forward pass
+   */
+  const SolverStatus& get_status() const;
+  /**
+   * @brief Return the node where the last pass failed (or stopped), or -1 if it succeeded or if the failure is not
+   * local to a node
+   */
+  const int& get_failedNode() const;
+  /**
+   * @brief Return the convergence history of the last solve, i.e. one row (of SolverHistoryField columns) per
+   * iteration that ran the callbacks
+   *
+   * It is a view of the contiguous (row-major) storage of the solver, which is overwritten by the next solve and
+   * invalidated by set_history_capacity.
+   */
+  HistoryMap get_history() const;
+  std::size_t get_history_capacity() const;
+  /**
+   * @brief Return the storage of the convergence history, whose first rows are the ones of get_history
+   *
+   * It is shared with the views that have to outlive a reallocation of the history (e.g. the Python ones).
+   */
+  boost::shared_ptr<const HistoryMatrix> get_history_storage() const;
 
  protected:
+  /**
+   * @brief Scoped timer that adds its lifetime to a phase of the solver
+   *
+   * The time is recorded in its destructor, so a phase is also accounted when it returns early.
+   */
+  class PhaseTimer {
+   public:
+    PhaseTimer(SolverAbstract& solver, const SolverPhase& phase) : solver_(solver), phase_(phase) {}
+    ~PhaseTimer() { solver_.addPhaseTime(phase_, timer_.get_duration()); }
+
+   private:
+    SolverAbstract& solver_;
+    SolverPhase phase_;
+    Timer timer_;
+  };
+
+  /**
+   * @brief Scoped guard that flushes the callbacks at the end of a solve, whichever way it returns
+   */
+  class CallbackFlush {
+   public:
+    explicit CallbackFlush(SolverAbstract& solver) : solver_(solver) {}
+    ~CallbackFlush() { solver_.flushCallbacks(); }
+
+   private:
+    SolverAbstract& solver_;
+  };
+
+  void flushCallbacks();
+  /**
+   * @brief Reset the cumulative timings (start of solve) and the ones of the iteration (start of each iteration)
+   *
+   * resetTimings also starts the clock of the time budget.
+   */
+  void resetTimings();
+  void resetIterTimings();
+  /**
+   * @brief Add the duration of a phase call, and update the prediction of the duration of its next call
+   */
+  void addPhaseTime(const SolverPhase& phase, const double& duration);
+  /**
+   * @brief Return the predicted duration [ms] of the next call of a phase
+   *
+   * It is a moving average of the measured durations, kept across the solves, which rises at once to a longer
+   * duration in order to be conservative with the time budget.
+   */
+  double predictPhaseTime(const SolverPhase& phase) const;
+  /**
+   * @brief Return true, and record it, if a work of the given duration [ms] would exceed the time budget
+   */
+  bool stopByBudget(const double& duration);
+  /**
+   * @brief Clear the convergence history (start of solve), and record the values of the current iteration in it
+   */
+  void resetHistory();
+  void recordIteration();
+  void addLineSearchTrial();
+  void addRegularizationRetry();
+  /**
+   * @brief Record the number of nodes whose derivatives were evaluated and reused by the last calcDiff of the problem
+   */
+  void addLinearizations();
+  /**
+   * @brief Record the outcome of a pass and return its status
+   */
+  const SolverStatus& setStatus(const SolverStatus& status, const int& node = -1);
+
+  /**
+   * @brief Rotate the candidate after shifting the problem, and warm-start the new last node
+   *
+   * By default, the last node keeps the last control and its next state is computed by rolling it out.
+   */
+  virtual void shiftCandidate();
+
   ShootingProblem& problem_;
   std::vector<ActionModelAbstract*> models_;
   std::vector<boost::shared_ptr<ActionDataAbstract> > datas_;
   std::vector<Eigen::VectorXd> xs_;
   std::vector<Eigen::VectorXd> us_;
+  std::vector<Eigen::VectorXd> xs_zero_;  //!< zero state of each node, used when there is no warm start
   std::vector<CallbackAbstract*> callbacks_;
   bool is_feasible_;
+  bool is_accepted_;
   double cost_;
   double stop_;
   Eigen::Vector2d d_;
@@ -72,13 +313,27 @@ class SolverAbstract {
   double th_acceptstep_;
   double th_stop_;
   unsigned int iter_;
+  SolverTimings timings_;       //!< cumulative timings of the last solve
+  SolverTimings iter_timings_;  //!< timings of the current (or last) iteration
+  SolverStatus status_;
+  int failed_node_;
+  double phase_times_[4];  //!< predicted duration of each phase [ms]
+  double time_budget_;
+  Timer budget_timer_;
+  bool stopped_by_budget_;
+  boost::shared_ptr<HistoryMatrix> history_;
+  std::size_t history_size_;  //!< number of recorded iterations
 };
 
 class CallbackAbstract {
  public:
   CallbackAbstract() {}
-  ~CallbackAbstract() {}
+  virtual ~CallbackAbstract() {}
   virtual void operator()(SolverAbstract& solver) = 0;
+  /**
+   * @brief Complete the work left by the previous calls, which is done at the end of each solve
+   */
+  virtual void flush() {}
 };
 
 bool raiseIfNaN(const double& value);
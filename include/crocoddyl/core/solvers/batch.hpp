@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_CORE_SOLVERS_BATCH_HPP_
+#define CROCODDYL_CORE_SOLVERS_BATCH_HPP_
+
+#include <vector>
+#include "crocoddyl/core/solvers/fddp.hpp"
+
+namespace crocoddyl {
+
+/**
+ * @brief Solve a shooting problem from many initial states
+ *
+ * The models of the problem are shared by all the solves, so they must not be modified while solving. Each thread
+ * has its own shooting problem (i.e. its own datas) and FDDP solver, which are allocated once. The solutions are
+ * stored in contiguous buffers, where the column i of xs (us) stacks the states (controls) of the solution of
+ * x0s[i] node by node.
+ */
+class SolverBatch {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  explicit SolverBatch(ShootingProblem& problem, const unsigned int& nthreads = 1);
+  ~SolverBatch();
+
+  /**
+   * @brief Solve the problem for each initial state, and return true if all the solves converged
+   *
+   * The warm starts are given in the layout of the solutions (e.g. the solutions of a previous batch), and empty
+   * matrices mean that there is no warm start.
+   */
+  bool solve(const std::vector<Eigen::VectorXd>& x0s, const Eigen::MatrixXd& init_xs = Eigen::MatrixXd(),
+             const Eigen::MatrixXd& init_us = Eigen::MatrixXd(), const unsigned int& maxiter = 100,
+             const bool& is_feasible = false, const double& reginit = NAN);
+
+  /**
+   * @brief Return the solver of each thread, e.g. for setting their thresholds
+   */
+  const std::vector<SolverFDDP*>& get_solvers() const;
+  const unsigned int& get_nthreads() const;
+  /**
+   * @brief Set the number of threads, it allocates the problems and solvers of the new threads
+   */
+  void set_nthreads(const unsigned int& nthreads);
+
+  const Eigen::MatrixXd& get_xs() const;
+  const Eigen::MatrixXd& get_us() const;
+  const Eigen::VectorXd& get_costs() const;
+  const Eigen::VectorXd& get_stops() const;
+  const std::vector<unsigned int>& get_iters() const;
+  const std::vector<bool>& get_converged() const;
+  /**
+   * @brief Return the wall time of the last batch [ms]
+   */
+  const double& get_duration() const;
+  /**
+   * @brief Return the number of solves per second of the last batch
+   */
+  double get_throughput() const;
+
+ protected:
+  ShootingProblem& problem_;
+  unsigned int nthreads_;
+  std::vector<ShootingProblem*> problems_;
+  std::vector<SolverFDDP*> solvers_;
+  std::vector<std::vector<Eigen::VectorXd> > init_xs_;  //!< warm start of each thread
+  std::vector<std::vector<Eigen::VectorXd> > init_us_;
+  std::vector<unsigned int> ix_;  //!< row of the state of each node in xs
+  std::vector<unsigned int> iu_;  //!< row of the control of each node in us
+
+  Eigen::MatrixXd xs_;
+  Eigen::MatrixXd us_;
+  Eigen::VectorXd costs_;
+  Eigen::VectorXd stops_;
+  std::vector<unsigned int> iters_;
+  std::vector<bool> converged_;
+  std::vector<unsigned char> solved_;  //!< solve results written by the threads, as std::vector<bool> packs bits
+  double duration_;
+
+ private:
+  void allocateWorkers();
+};
+
+}  // namespace crocoddyl
+
+#endif  // CROCODDYL_CORE_SOLVERS_BATCH_HPP_
@@ -9,6 +9,60 @@
 #ifndef CROCODDYL_CORE_SOLVERS_BOX_DDP_HPP_
 #define CROCODDYL_CORE_SOLVERS_BOX_DDP_HPP_
 
-// TODO: SolverBoxDDP
+#include <Eigen/Cholesky>
+#include <vector>
+#include "crocoddyl/core/solvers/ddp.hpp"
+#include "crocoddyl/core/solvers/box-qp.hpp"
+
+namespace crocoddyl {
+
+/**
+ * @brief Control-limited DDP solver
+ *
+ * It runs the control-limited DDP proposed in Tassa, Mansard and Todorov, "Control-Limited Differential Dynamic
+ * Programming", ICRA 2014. The feed-forward term is computed by a projected-Newton box QP, which is warm-started
+ * from the previous feed-forward term (and its active set), and the feedback gains of the clamped controls are zero.
+ * The forward pass clamps the controls inside the limits, and the stopping criteria only considers the gradient of
+ * the controls that are not pushed against their limits.
+ */
+class SolverBoxDDP : public SolverDDP {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  explicit SolverBoxDDP(ShootingProblem& problem);
+  ~SolverBoxDDP();
+
+  double stoppingCriteria();
+
+  const Eigen::VectorXd& get_ul() const;
+  const Eigen::VectorXd& get_uu() const;
+  void set_ul(const Eigen::VectorXd& ul);
+  void set_uu(const Eigen::VectorXd& uu);
+  /**
+   * @brief The backward pass is always serial, as the clamped gains aren't affine in the next value function
+   */
+  void set_nthreads_riccati(const unsigned int& nthreads);
+
+ protected:
+  /**
+   * @brief Compute the gains by the box QP, and return false if it didn't converge
+   */
+  bool computeGains(unsigned int const& t);
+  /**
+   * @brief Clamp the control of a rollout inside the limits
+   */
+  void clampControl(const unsigned int& t, Eigen::VectorXd& u) const;
+
+  Eigen::VectorXd ul_;
+  Eigen::VectorXd uu_;
+
+ private:
+  BoxQP qp_;
+  Eigen::VectorXd du_lb_;
+  Eigen::VectorXd du_ub_;
+  Eigen::VectorXd du_init_;
+};
+
+}  // namespace crocoddyl
 
 #endif  // CROCODDYL_CORE_SOLVERS_BOX_DDP_HPP_
@@ -0,0 +1,78 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_CORE_SOLVERS_BOX_QP_HPP_
+#define CROCODDYL_CORE_SOLVERS_BOX_QP_HPP_
+
+#include <Eigen/Dense>
+#include <Eigen/Cholesky>
+#include <vector>
+
+namespace crocoddyl {
+
+/**
+ * @brief Projected-Newton solver for box-constrained QPs
+ *
+ * It solves min 0.5 x^T H x + q^T x s.t. lb <= x <= ub, as described in Tassa, Mansard and Todorov,
+ * "Control-Limited Differential Dynamic Programming", ICRA 2014. The clamped coordinates are decoupled by
+ * replacing their rows and columns of H by the identity, so the Cholesky factorization of the free Hessian keeps
+ * the size of the problem. Thus, after allocating the solver, solve doesn't allocate memory.
+ */
+class BoxQP {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  explicit BoxQP(const unsigned int& nx, const unsigned int& maxiter = 100, const double& th_acceptstep = 0.1,
+                 const double& th_grad = 1e-9, const double& th_relimprove = 1e-8);
+  ~BoxQP();
+
+  /**
+   * @brief Solve the box QP starting from xinit
+   *
+   * The initial guess is projected onto the box, and it defines the initial active set. It returns true if the
+   * projected gradient has converged, or if the cost cannot decrease further, i.e. the relative improvement of the
+   * last step is below th_relimprove or the projected line search fails. In that case, the solution is the current
+   * iterate, whose clamped set and free Hessian are the ones returned by the getters.
+   */
+  bool solve(const Eigen::Ref<const Eigen::MatrixXd>& H, const Eigen::Ref<const Eigen::VectorXd>& q,
+             const Eigen::Ref<const Eigen::VectorXd>& lb, const Eigen::Ref<const Eigen::VectorXd>& ub,
+             const Eigen::Ref<const Eigen::VectorXd>& xinit);
+
+  const unsigned int& get_nx() const;
+  const Eigen::VectorXd& get_x() const;
+  const std::vector<bool>& get_clamped() const;
+  const unsigned int& get_nfree() const;
+  const Eigen::LLT<Eigen::MatrixXd>& get_Hff_llt() const;
+  const unsigned int& get_iter() const;
+
+ private:
+  void factorizeFreeHessian(const Eigen::Ref<const Eigen::MatrixXd>& H);
+
+  unsigned int nx_;
+  unsigned int maxiter_;
+  double th_acceptstep_;
+  double th_grad_;
+  double th_relimprove_;
+
+  Eigen::VectorXd x_;
+  Eigen::VectorXd xnew_;
+  Eigen::VectorXd g_;
+  Eigen::VectorXd dx_;
+  Eigen::VectorXd Hx_;
+  Eigen::MatrixXd Hff_;
+  Eigen::LLT<Eigen::MatrixXd> Hff_llt_;
+  std::vector<bool> clamped_;
+  std::vector<bool> clamped_prev_;
+  std::vector<double> alphas_;
+  unsigned int nfree_;
+  unsigned int iter_;
+};
+
+}  // namespace crocoddyl
+
+#endif  // CROCODDYL_CORE_SOLVERS_BOX_QP_HPP_
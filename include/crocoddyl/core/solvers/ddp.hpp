@@ -10,15 +10,45 @@
 #define CROCODDYL_CORE_SOLVERS_DDP_HPP_
 
 #include <Eigen/Cholesky>
+#include <Eigen/LU>
+#include <limits>
 #include <vector>
 #include "crocoddyl/core/solver-base.hpp"
 
 namespace crocoddyl {
 
+/**
+ * @brief DDP solver
+ *
+ * The Riccati workspace (i.e. the value function, its Q-function, the gains and the factorization of Quu) lives in a
+ * single arena laid out node by node, so the backward pass walks the memory backwards without jumping between the
+ * per-node allocations. Each block starts at a cache line, and the nodes are exposed as Eigen maps over the arena.
+ *
+ * The backward pass can optionally propagate the Cholesky factor L of Vxx (i.e. Vxx = L * L^T) instead of Vxx itself
+ * (see set_sqrt_riccati). The Hessian of the Q-function is then built as Lxx + (Fx^T L) * (Fx^T L)^T, so it stays
+ * positive semidefinite whenever the cost Hessians are. The factor of the value function is the one of Qxx + xreg
+ * downdated by the rows of Quu^(1/2)^T K, i.e. Vxx is never computed by subtracting Qxu * K from Qxx, and a value
+ * function that is not positive definite is detected by the downdate at the node where it happens. It requires
+ * positive semidefinite cost Hessians, which is the case of the Gauss-Newton approximations.
+ *
+ * When a lower bound of the cost of each node is known (e.g. 0 for non-negative costs, see set_cost_lower_bound), the
+ * line search stops a rollout as soon as its partial cost plus the bound of the remaining nodes cannot pass the
+ * acceptance test, so most of the rejected trials only roll out a part of the horizon.
+ *
+ * For long horizons, the backward pass can be partitioned in time (see set_nthreads_riccati). The horizon is split in
+ * segments, and each segment is reduced in parallel to a map from the value function at its end to the one at its
+ * start (i.e. the Riccati recursion of the segment with a zero terminal value function, its closed-loop transition and
+ * its controllability Gramian). A serial sweep over these maps gives the value functions at the boundaries of the
+ * segments, and then the segments run the standard recursion in parallel. So it computes the same gains as the serial
+ * recursion (up to round-off errors), for about three times its work.
+ */
 class SolverDDP : public SolverAbstract {
  public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
+  typedef Eigen::Map<Eigen::MatrixXd, Eigen::Aligned> MatrixMap;
+  typedef Eigen::Map<Eigen::VectorXd, Eigen::Aligned> VectorMap;
+
   explicit SolverDDP(ShootingProblem& problem);
   ~SolverDDP();
 
@@ -27,12 +57,37 @@ class SolverDDP : public SolverAbstract {
              const bool& is_feasible = false, const double& regInit = 1e-9);
   void computeDirection(const bool& recalc = true);
   double tryStep(const double& steplength = 1);
+  void setCandidate(const std::vector<Eigen::VectorXd>& xs_warm = DEFAULT_VECTOR,
+                    const std::vector<Eigen::VectorXd>& us_warm = DEFAULT_VECTOR, const bool& is_feasible = false);
   double stoppingCriteria();
   const Eigen::Vector2d& expectedImprovement();
-  double calc();
-  void backwardPass();
-  void forwardPass(const double& stepLength);
+  /**
+   * @brief Compute the terms of the expected improvement that are known before the line search
+   *
+   * The DDP solver computes the whole expected improvement, while the derived solvers can complete it for each trial
+   * (see acceptStep).
+   */
+  virtual void updateExpectedImprovement();
+  virtual double calc();
+  /**
+   * @brief Run the Riccati sweep, and return a backward error at the first node whose value function is not finite
+   */
+  virtual SolverStatus backwardPass();
+  /**
+   * @brief Rollout the policy, and return a forward error at the first node whose cost or next state is not finite
+   *
+   * The rollout is stopped, and the step rejected, once its cost is known to exceed cost_max (see
+   * set_cost_lower_bound).
+   */
+  virtual SolverStatus forwardPass(const double& stepLength,
+                                   const double& cost_max = std::numeric_limits<double>::infinity());
 
+  /**
+   * @brief Return copies of the Riccati workspace of the nodes
+   *
+   * The copies are refreshed when the workspace changed since the last call. The get_*_map accessors return the maps
+   * over the arena instead, without copying it.
+   */
   const std::vector<Eigen::MatrixXd>& get_Vxx() const;
   const std::vector<Eigen::VectorXd>& get_Vx() const;
   const std::vector<Eigen::MatrixXd>& get_Qxx() const;
@@ -42,15 +97,186 @@ class SolverDDP : public SolverAbstract {
   const std::vector<Eigen::VectorXd>& get_Qu() const;
   const std::vector<Eigen::MatrixXd>& get_K() const;
   const std::vector<Eigen::VectorXd>& get_k() const;
+  const std::vector<MatrixMap>& get_Vxx_map() const;
+  const std::vector<VectorMap>& get_Vx_map() const;
+  const std::vector<MatrixMap>& get_Qxx_map() const;
+  const std::vector<MatrixMap>& get_Qxu_map() const;
+  const std::vector<MatrixMap>& get_Quu_map() const;
+  const std::vector<VectorMap>& get_Qx_map() const;
+  const std::vector<VectorMap>& get_Qu_map() const;
+  const std::vector<MatrixMap>& get_K_map() const;
+  const std::vector<VectorMap>& get_k_map() const;
   const std::vector<Eigen::VectorXd>& get_gaps() const;
+  const unsigned int& get_nthreads_linesearch() const;
+  const unsigned int& get_nthreads_riccati() const;
+  const bool& get_sqrt_riccati() const;
+  const double& get_cost_lower_bound() const;
+  void set_nthreads_linesearch(const unsigned int& nthreads);
+  /**
+   * @brief Set the number of threads (i.e. of segments of the horizon) of the backward pass (1 by default)
+   *
+   * The partitioned recursion eliminates the controls of the last node of each segment without the value function of
+   * the next node, so it needs Luu + ureg to be positive definite (e.g. positive semidefinite Luu). Without control
+   * regularization (NaN), if the horizon is too short for the segments, or if the nodes have different state
+   * dimensions, the serial recursion is run.
+   */
+  virtual void set_nthreads_riccati(const unsigned int& nthreads);
+  /**
+   * @brief Select the square-root (true) or the standard (false, default) Riccati recursion
+   */
+  void set_sqrt_riccati(const bool& sqrt_riccati);
+  /**
+   * @brief Set a lower bound of the cost of each node for stopping the rejected rollouts early
+   *
+   * For instance, it is 0 for non-negative costs. The default (-inf) always rolls out the whole horizon.
+   */
+  void set_cost_lower_bound(const double& cost_lb);
 
- private:
-  void computeGains(unsigned int const& t);
+ protected:
+  /**
+   * @brief Rotate the candidate and the node buffers, and warm-start the new last node from the feedback policy
+   *
+   * The control of the new last node is given by the feedback policy of the previous last node evaluated at its next
+   * state, i.e. u = us[T-1] - K[T-1] * diff(xs[T-1], xs[T]).
+   */
+  void shiftCandidate();
+  /**
+   * @brief Rollout the policy with a given step length over the given trial buffers
+   *
+   * It computes the cost of the rollout, and node is the node where the rollout diverged (T for the terminal node) or
+   * where it was stopped because its cost exceeds cost_max, otherwise -1. It only reads the solver's members, so the
+   * parallel line search runs it concurrently over separate buffers (and datas). The derived solvers override it for
+   * defining their own rollouts.
+   */
+  virtual SolverStatus forwardPassTrial(const double& steplength, const double& cost_max,
+                                        std::vector<boost::shared_ptr<ActionDataAbstract> >& running_datas,
+                                        boost::shared_ptr<ActionDataAbstract>& terminal_data,
+                                        std::vector<Eigen::VectorXd>& xs_try, std::vector<Eigen::VectorXd>& us_try,
+                                        std::vector<Eigen::VectorXd>& dx, double& cost, int& node);
+  /**
+   * @brief Modify the control of the running node t of a rollout, e.g. to clamp it inside its limits (nothing by
+   * default)
+   *
+   * It is called by the rollouts of the line search, so it has to be thread safe.
+   */
+  virtual void clampControl(const unsigned int& t, Eigen::VectorXd& u) const;
+  /**
+   * @brief Return the cost above which the trial of a step length is rejected by the line search
+   *
+   * It is +inf if there is no lower bound of the node costs or if the acceptance test depends on the rollout.
+   */
+  virtual double computeRejectionCost(const double& steplength) const;
+  /**
+   * @brief Try the i-th step length of the line search
+   *
+   * With nthreads_linesearch > 1, the step lengths are rolled out by batches of nthreads_linesearch in parallel, and
+   * the trial of the i-th step length is swapped into xs_try_, us_try_ and dx_. The step lengths have to be tried in
+   * order, so the solver still accepts the largest step length that passes the acceptance test. The outcome of the
+   * trial is recorded as the solver's status.
+   */
+  double tryLineSearchStep(const unsigned int& i);
+  /**
+   * @brief Compute the expected improvement (dVexp) of the trial of the current step length, and return true if the
+   * line search accepts it
+   */
+  virtual bool acceptStep();
+  /**
+   * @brief Return true if the accepted trial is a feasible candidate, i.e. if it was rolled out without gaps
+   */
+  virtual bool isTrialFeasible() const;
+  /**
+   * @brief Return the predicted duration [ms] of an iteration that tries a single step length
+   */
+  double predictIterationTime(const bool& recalc) const;
+  void forwardPassBatch(const unsigned int& first);
+  /**
+   * @brief Make the evaluation of the accepted trial the evaluation of the new candidate
+   *
+   * It has to be called after setting the accepted trial as candidate. The datas of the accepted trial already hold
+   * calc at the new candidate, so the next calc only runs calcDiff (i.e. recalc=false). The parallel line search
+   * evaluates the trials on their own datas, which are swapped with the problem's datas.
+   */
+  void acceptTrialDatas();
+  /**
+   * @brief Compute the gains of the running node t, and return false if they cannot be computed
+   *
+   * The DDP solver fails if Quu (regularized) is not positive definite.
+   */
+  virtual bool computeGains(unsigned int const& t);
+  /**
+   * @brief Run the Riccati recursion of the running node t, i.e. compute its Q-function, gains and value function
+   *
+   * It returns false if the gains cannot be computed or the value function is not finite. It only writes the node's
+   * workspace, so the nodes of different segments can be computed concurrently.
+   */
+  bool computeValueFunction(const unsigned int& t);
+  /**
+   * @brief Compute Qxx, Qxu and Quu of the running node t from the value function of the next node
+   *
+   * Fx^T * Vxx_p is stored in Vxx of the node t, which is overwritten later by its own value function.
+   */
+  void computeActionValueHessian(const unsigned int& t);
+  /**
+   * @brief Compute Qx and Qu of the running node t from the value function of the next node and its gap
+   */
+  virtual void computeActionValueGradient(const unsigned int& t);
+  /**
+   * @brief Express the gradient of the value function of the node t at its rollout state (used by the derived
+   * solvers)
+   */
+  virtual void shiftValueGradient(const unsigned int& t);
+  /**
+   * @brief Run the partitioned backward pass over nseg segments
+   *
+   * It returns false if the maps of the segments cannot be computed or if the nodes don't fit the workspace of the
+   * segments, in which case the serial recursion has to be run.
+   * Otherwise the outcome of the pass is recorded as the solver's status.
+   */
+  bool partitionedBackwardPass(const unsigned int& nseg);
+  /**
+   * @brief Reduce the segment s to the map of the value function at its end to the one at its start
+   */
+  bool computeSegmentMap(const unsigned int& s);
+  /**
+   * @brief Compute Vxx of the node t from its Q-function and gains
+   *
+   * The square-root variant computes the Cholesky factor of Vxx from the ones of Qxx and Quu, and then Vxx from its
+   * factor. It returns false if Vxx isn't positive definite.
+   */
+  bool computeValueHessian(const unsigned int& t);
+  /**
+   * @brief Factorize the value function of the node t, i.e. of the terminal node or of a boundary of the partitioned
+   * backward pass, in the square-root variant
+   */
+  bool factorizeValueHessian(const unsigned int& t);
   void increaseRegularization();
   void decreaseRegularization();
   void allocateData();
+  /**
+   * @brief Point the maps of the running node t to its block of the Riccati arena
+   */
+  void mapNodeData(const unsigned int& t);
+  void allocateLineSearchData();
+  /**
+   * @brief Allocate the workspace of the segments of the partitioned backward pass
+   *
+   * It returns false if the nodes have different state dimensions, in which case there is no segment and the serial
+   * recursion is run.
+   */
+  bool allocateRiccatiData();
+
+  /**
+   * @brief Copy of the Riccati workspace of the nodes, as returned by the getters
+   */
+  template <typename Dense>
+  struct NodeCopies {
+    NodeCopies() : revision(0) {}
+    std::vector<Dense> nodes;
+    unsigned long revision;  //!< revision of the workspace when it was copied
+  };
+  template <typename Map, typename Dense>
+  const std::vector<Dense>& copyNodes(const std::vector<Map>& maps, NodeCopies<Dense>& copies) const;
 
- protected:
   double regfactor_;
   double regmin_;
   double regmax_;
@@ -61,29 +287,72 @@ class SolverDDP : public SolverAbstract {
   std::vector<Eigen::VectorXd> dx_;
 
   // allocate data
-  std::vector<Eigen::MatrixXd> Vxx_;
-  std::vector<Eigen::VectorXd> Vx_;
-  std::vector<Eigen::MatrixXd> Qxx_;
-  std::vector<Eigen::MatrixXd> Qxu_;
-  std::vector<Eigen::MatrixXd> Quu_;
-  std::vector<Eigen::VectorXd> Qx_;
-  std::vector<Eigen::VectorXd> Qu_;
-  std::vector<Eigen::MatrixXd> K_;
-  std::vector<Eigen::VectorXd> k_;
+  Eigen::VectorXd arena_;             //!< Riccati workspace of all the nodes
+  std::vector<double*> node_blocks_;  //!< first entry of the running nodes in the arena
+  std::vector<MatrixMap> Vxx_;
+  std::vector<MatrixMap> Vxx_factor_;  //!< storage of the Cholesky factorization of Vxx (square-root variant)
+  std::vector<VectorMap> Vx_;
+  std::vector<MatrixMap> Qxx_;
+  std::vector<MatrixMap> Qxu_;
+  std::vector<MatrixMap> Quu_;
+  std::vector<VectorMap> Qx_;
+  std::vector<VectorMap> Qu_;
+  std::vector<MatrixMap> K_;
+  std::vector<VectorMap> k_;
   std::vector<Eigen::VectorXd> gaps_;
+  unsigned long riccati_revision_;  //!< incremented each time the Riccati workspace changes
+  mutable NodeCopies<Eigen::MatrixXd> Vxx_copy_;
+  mutable NodeCopies<Eigen::VectorXd> Vx_copy_;
+  mutable NodeCopies<Eigen::MatrixXd> Qxx_copy_;
+  mutable NodeCopies<Eigen::MatrixXd> Qxu_copy_;
+  mutable NodeCopies<Eigen::MatrixXd> Quu_copy_;
+  mutable NodeCopies<Eigen::VectorXd> Qx_copy_;
+  mutable NodeCopies<Eigen::VectorXd> Qu_copy_;
+  mutable NodeCopies<Eigen::MatrixXd> K_copy_;
+  mutable NodeCopies<Eigen::VectorXd> k_copy_;
 
- private:
   Eigen::VectorXd xnext_;
-  Eigen::VectorXd x_reg_;
-  Eigen::MatrixXd FxTVxx_p_;
-  std::vector<Eigen::MatrixXd> FuTVxx_p_;
+  std::vector<MatrixMap> FxTVxx_p_;  //!< Fx^T * Vxx_p, or Fx^T * L_p in the square-root variant
+  std::vector<MatrixMap> FuTVxx_p_;  //!< Fu^T * Vxx_p, or Fu^T * L_p and then Lu^T * K in the square-root variant
+  std::vector<VectorMap> Vx_gap_;    //!< gradient of the next value function at the rollout state, Vx_p + Vxx_p * gap
   Eigen::VectorXd fTVxx_p_;
-  std::vector<Eigen::LLT<Eigen::MatrixXd> > Quu_llt_;
-  std::vector<Eigen::VectorXd> Quuk_;
+  std::vector<MatrixMap> Quu_factor_;  //!< storage of the Cholesky factorization of Quu (Lu)
+  std::vector<VectorMap> Quuk_;
   std::vector<double> alphas_;
   double th_grad_;
   double th_step_;
   bool was_feasible_;
+  bool sqrt_riccati_;
+  double cost_lb_;  //!< lower bound of the cost of each node
+  bool is_calc_updated_;  //!< true when the problem's datas hold calc at the candidate (xs_, us_)
+
+  // line-search trials, one per thread
+  unsigned int nthreads_ls_;
+  unsigned int ls_trial_;  //!< trial swapped into xs_try_ and us_try_ by the last tryLineSearchStep
+  std::vector<std::vector<boost::shared_ptr<ActionDataAbstract> > > ls_running_datas_;
+  std::vector<boost::shared_ptr<ActionDataAbstract> > ls_terminal_datas_;
+  std::vector<std::vector<Eigen::VectorXd> > ls_xs_try_;
+  std::vector<std::vector<Eigen::VectorXd> > ls_us_try_;
+  std::vector<std::vector<Eigen::VectorXd> > ls_dx_;
+  std::vector<double> ls_cost_try_;
+  std::vector<SolverStatus> ls_status_;
+  std::vector<int> ls_node_;  //!< node where the rollout of each trial failed or stopped, or -1
+
+  // segments of the partitioned backward pass, one per thread
+  unsigned int nthreads_riccati_;
+  std::vector<unsigned int> seg_first_;  //!< first node of each segment, and T at the end
+  std::vector<Eigen::MatrixXd> seg_A_;   //!< closed-loop transition from the start to the end of each segment
+  std::vector<Eigen::MatrixXd> seg_A_next_;
+  std::vector<Eigen::MatrixXd> seg_C_;  //!< controllability Gramian of each segment, weighted by Quu^-1
+  std::vector<Eigen::VectorXd> seg_c_;  //!< closed-loop drift of each segment
+  std::vector<Eigen::VectorXd> seg_p_;  //!< value gradient at the start of each segment (without terminal value)
+  std::vector<Eigen::MatrixXd> seg_G_;  //!< scratch of A * Fu for each segment
+  std::vector<int> seg_node_;           //!< node where the recursion of each segment failed, or -1
+  Eigen::PartialPivLU<Eigen::MatrixXd> coupling_lu_;
+  Eigen::MatrixXd coupling_M_;
+  Eigen::MatrixXd coupling_SA_;
+  Eigen::VectorXd coupling_v_;
+  Eigen::VectorXd coupling_s_;
 };
 
 }  // namespace crocoddyl
@@ -9,6 +9,89 @@
 #ifndef CROCODDYL_CORE_SOLVERS_FDDP_HPP_
 #define CROCODDYL_CORE_SOLVERS_FDDP_HPP_
 
-// TODO: SolverFDDP
+#include <Eigen/Cholesky>
+#include <vector>
+#include "crocoddyl/core/solvers/ddp.hpp"
+
+namespace crocoddyl {
+
+/**
+ * @brief Feasibility-driven DDP solver
+ *
+ * In the multiple-shooting mode (see set_multiple_shooting), the trial state of each node is predicted by the
+ * linearized dynamics, i.e. xs_try[t] = xs[t] + dx[t] with dx[t+1] = Fx * dx[t] + Fu * du[t] + alpha * gap[t+1],
+ * instead of being rolled out. The prediction only needs matrix-vector products, and then the nodes of the trial are
+ * evaluated in parallel (see ShootingProblem::set_nthreads). The defects of the trial, which are of the order of the
+ * linearization error, become the gaps of the next candidate. A candidate is feasible once its gaps are below
+ * th_gaptol, and only then the solver can stop.
+ */
+class SolverFDDP : public SolverDDP {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  explicit SolverFDDP(ShootingProblem& problem);
+  ~SolverFDDP();
+
+  const Eigen::Vector2d& expectedImprovement();
+  void updateExpectedImprovement();
+  double calc();
+
+  const double& get_th_acceptnegstep() const;
+  const bool& get_multiple_shooting() const;
+  const double& get_th_gaptol() const;
+  void set_th_acceptnegstep(const double& th_acceptnegstep);
+  /**
+   * @brief Select the multiple-shooting (true) or the rollout (false, default) line search
+   */
+  void set_multiple_shooting(const bool& multiple_shooting);
+  /**
+   * @brief Set the largest gap (infinity norm) of a feasible candidate in the multiple-shooting mode (1e-9 by default)
+   */
+  void set_th_gaptol(const double& th_gaptol);
+
+ protected:
+  /**
+   * @brief Accept a trial that decreases the cost as DDP, or one that reduces the gaps for a small increment of the
+   * cost (see th_acceptnegstep)
+   */
+  bool acceptStep();
+  bool isTrialFeasible() const;
+  SolverStatus forwardPassTrial(const double& steplength, const double& cost_max,
+                                std::vector<boost::shared_ptr<ActionDataAbstract> >& running_datas,
+                                boost::shared_ptr<ActionDataAbstract>& terminal_data,
+                                std::vector<Eigen::VectorXd>& xs_try, std::vector<Eigen::VectorXd>& us_try,
+                                std::vector<Eigen::VectorXd>& dx, double& cost, int& node);
+  /**
+   * @brief Return the rejection cost of a step length, which is only known before the rollout if it is feasible
+   */
+  double computeRejectionCost(const double& steplength) const;
+  /**
+   * @brief Predict the trial of a step length by the linearized dynamics, and evaluate its nodes in parallel
+   *
+   * It ignores cost_max, as all the nodes are evaluated at once.
+   */
+  SolverStatus forwardPassMultipleShooting(const double& steplength,
+                                           std::vector<boost::shared_ptr<ActionDataAbstract> >& running_datas,
+                                           boost::shared_ptr<ActionDataAbstract>& terminal_data,
+                                           std::vector<Eigen::VectorXd>& xs_try, std::vector<Eigen::VectorXd>& us_try,
+                                           std::vector<Eigen::VectorXd>& dx, double& cost, int& node);
+  /**
+   * @brief Compute Qx and Qu of the running node t, whose next value gradient is already at the rollout state
+   */
+  void computeActionValueGradient(const unsigned int& t);
+  /**
+   * @brief Store the gradient of the value function of the node t at its rollout state, i.e. Vx + Vxx * gap
+   */
+  void shiftValueGradient(const unsigned int& t);
+
+  double dg_;
+  double dq_;
+  double dv_;
+  double th_acceptnegstep_;
+  bool multiple_shooting_;
+  double th_gaptol_;
+};
+
+}  // namespace crocoddyl
 
 #endif  // CROCODDYL_CORE_SOLVERS_FDDP_HPP_
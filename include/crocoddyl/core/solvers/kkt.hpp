@@ -9,6 +9,84 @@
 #ifndef CROCODDYL_CORE_SOLVERS_KKT_HPP_
 #define CROCODDYL_CORE_SOLVERS_KKT_HPP_
 
-// TODO: SolverKKT
+#include <Eigen/Sparse>
+#include <Eigen/SparseLU>
+#include <vector>
+#include "crocoddyl/core/solver-base.hpp"
+
+namespace crocoddyl {
+
+/**
+ * @brief KKT solver of the multiple-shooting problem
+ *
+ * It computes the Newton step of the equality-constrained problem by solving its KKT system. The rows and columns
+ * of the KKT matrix are ordered stage-wise, i.e. (lambda_t, dx_t, du_t) for each node, so the matrix is banded and it
+ * is stored as a sparse matrix. Its sparsity pattern is analyzed once, and the numerical factorization (sparse LU
+ * with partial pivoting, as the KKT matrix is indefinite) has a cost and memory that grow linearly with the horizon.
+ */
+class SolverKKT : public SolverAbstract {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  explicit SolverKKT(ShootingProblem& problem);
+  ~SolverKKT();
+
+  bool solve(const std::vector<Eigen::VectorXd>& init_xs = DEFAULT_VECTOR,
+             const std::vector<Eigen::VectorXd>& init_us = DEFAULT_VECTOR, unsigned int const& maxiter = 100,
+             const bool& is_feasible = false, const double& regInit = 1e-9);
+  void computeDirection(const bool& recalc = true);
+  double tryStep(const double& steplength = 1);
+  double stoppingCriteria();
+  const Eigen::Vector2d& expectedImprovement();
+  double calc();
+  /**
+   * @brief Solve the KKT system, and return a backward error if it is singular (the failure is not local to a node)
+   */
+  SolverStatus computePrimalDual();
+
+  const Eigen::SparseMatrix<double>& get_kkt() const;
+  const Eigen::VectorXd& get_kktref() const;
+  const Eigen::VectorXd& get_primaldual() const;
+  const std::vector<Eigen::VectorXd>& get_dxs() const;
+  const std::vector<Eigen::VectorXd>& get_dus() const;
+  const std::vector<Eigen::VectorXd>& get_lambdas() const;
+  const unsigned int& get_nx() const;
+  const unsigned int& get_ndx() const;
+  const unsigned int& get_nu() const;
+
+ protected:
+  double cost_try_;
+  std::vector<Eigen::VectorXd> xs_try_;
+  std::vector<Eigen::VectorXd> us_try_;
+  std::vector<Eigen::VectorXd> dxs_;
+  std::vector<Eigen::VectorXd> dus_;
+  std::vector<Eigen::VectorXd> lambdas_;
+
+ private:
+  void allocateData();
+  void setBlock(const unsigned int& row, const unsigned int& col, const Eigen::MatrixXd& block,
+                const double& sign = 1., const bool& transpose = false);
+  void setDiagonal(const unsigned int& row, const unsigned int& col, const unsigned int& n, const double& value);
+  void increaseRegularization();
+  void decreaseRegularization();
+
+  unsigned int nx_;
+  unsigned int ndx_;
+  unsigned int nu_;
+  std::vector<unsigned int> ilambda_;
+  std::vector<unsigned int> idx_;
+  std::vector<unsigned int> idu_;
+  Eigen::SparseMatrix<double> kkt_;
+  Eigen::SparseLU<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int> > kkt_lu_;
+  Eigen::VectorXd kktref_;
+  Eigen::VectorXd primaldual_;
+  std::vector<double> alphas_;
+  double regfactor_;
+  double regmin_;
+  double regmax_;
+  double th_grad_;
+};
+
+}  // namespace crocoddyl
 
 #endif  // CROCODDYL_CORE_SOLVERS_KKT_HPP_
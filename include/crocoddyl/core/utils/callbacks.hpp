@@ -11,6 +11,12 @@
 
 #include <iostream>
 #include <iomanip>
+#include <boost/cstdint.hpp>
+#ifdef CROCODDYL_WITH_ASYNC_CALLBACKS
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#endif
 #include "crocoddyl/core/solver-base.hpp"
 
 namespace crocoddyl {
@@ -27,6 +33,107 @@ class CallbackVerbose : public CallbackAbstract {
   VerboseLevel level;
 };
 
+/**
+ * @brief Fixed-size record of the values of a solver iteration
+ */
+struct IterationRecord {
+  /**
+   * @brief Copy the values of the current iteration of the solver
+   */
+  void update(const SolverAbstract& solver);
+
+  unsigned int iter;
+  double cost;
+  double stop;
+  double d[2];  //!< terms of the expected improvement
+  double xreg;
+  double ureg;
+  double steplength;
+  double dV;
+  double dVexp;
+  bool is_feasible;
+  bool is_accepted;
+  SolverTimings timings;  //!< timings of the iteration
+};
+
+/**
+ * @brief Abstract class of the callbacks run by CallbackAsync, which receive a record instead of the solver
+ */
+class IterationCallbackAbstract {
+ public:
+  IterationCallbackAbstract() {}
+  virtual ~IterationCallbackAbstract() {}
+  virtual void operator()(const IterationRecord& record) = 0;
+};
+
+/**
+ * @brief Print the values of an iteration record, as CallbackVerbose does
+ */
+class IterationCallbackVerbose : public IterationCallbackAbstract {
+ public:
+  explicit IterationCallbackVerbose(VerboseLevel level = _1);
+  ~IterationCallbackVerbose();
+
+  void operator()(const IterationRecord& record);
+
+ private:
+  VerboseLevel level;
+};
+
+#ifdef CROCODDYL_WITH_ASYNC_CALLBACKS
+/**
+ * @brief Run callbacks on a background thread, so they don't add their latency to the solver iterations
+ *
+ * The solver thread only copies a fixed-size IterationRecord into a single-producer single-consumer ring, without
+ * locks or memory allocations, and the dispatcher thread runs the callbacks on the queued records. The ring has a
+ * fixed capacity: if the callbacks fall behind and the ring is full, the new records are dropped (and counted) instead
+ * of blocking the solver. At the end of each solve, flush waits until the dispatcher has run the callbacks on all the
+ * queued records, so the solve returns once they are done.
+ *
+ * It is only available if the library was built with CROCODDYL_WITH_ASYNC_CALLBACKS (BUILD_WITH_ASYNC_CALLBACKS),
+ * since it needs Boost.Thread.
+ */
+class CallbackAsync : public CallbackAbstract {
+ public:
+  explicit CallbackAsync(const std::size_t& capacity = 64);
+  ~CallbackAsync();
+
+  void operator()(SolverAbstract& solver);
+  /**
+   * @brief Wait until the callbacks have run on all the queued records
+   */
+  void flush();
+  /**
+   * @brief Set the callbacks run by the dispatcher thread, after flushing the queued records
+   */
+  void setCallbacks(const std::vector<IterationCallbackAbstract*>& callbacks);
+
+  const std::size_t& get_capacity() const;
+  /**
+   * @brief Return the number of records dropped because the ring was full
+   */
+  const boost::uint64_t& get_dropped() const;
+  /**
+   * @brief Return the number of records on which the callbacks have run
+   */
+  boost::uint64_t get_dispatched() const;
+
+ private:
+  void dispatch();
+
+  std::vector<IterationRecord> records_;
+  std::size_t capacity_;
+  boost::atomic<boost::uint64_t> head_;  //!< number of queued records, written by the solver thread
+  char padding_[64];                     //!< keeps head_ and tail_ in different cache lines
+  boost::atomic<boost::uint64_t> tail_;  //!< number of dispatched records, written by the dispatcher thread
+  boost::atomic<bool> running_;
+  boost::uint64_t dropped_;
+  std::vector<IterationCallbackAbstract*> callbacks_;
+  boost::mutex callbacks_mutex_;  //!< taken by the dispatcher thread and setCallbacks, never by the solver thread
+  boost::thread thread_;
+};
+#endif  // CROCODDYL_WITH_ASYNC_CALLBACKS
+
 }  // namespace crocoddyl
 
 #endif  // CROCODDYL_CORE_UTILS_CALLBACKS_HPP_
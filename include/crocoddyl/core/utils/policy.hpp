@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_CORE_UTILS_POLICY_HPP_
+#define CROCODDYL_CORE_UTILS_POLICY_HPP_
+
+#include <vector>
+#include <boost/atomic.hpp>
+#include "crocoddyl/core/solvers/ddp.hpp"
+
+namespace crocoddyl {
+
+/**
+ * @brief Feedback policy of a solver, i.e. u = us[t] - K[t] * diff(xs[t], x) around the node t
+ */
+struct PolicySnapshot {
+  std::vector<Eigen::VectorXd> xs;
+  std::vector<Eigen::VectorXd> us;
+  std::vector<Eigen::MatrixXd> K;
+  std::vector<double> ts;  //!< time of each node, i.e. of xs
+  double cost;
+  unsigned int iter;
+  unsigned long sequence;  //!< number of the publication, 0 if nothing was published yet
+};
+
+/**
+ * @brief Hand off the feedback policy of a DDP solver to another thread
+ *
+ * As a callback, it publishes the policy after each iteration that accepted a step. The policy is copied into one
+ * of three buffers allocated once, so the solver (writer) and the control thread (reader) never wait for each other
+ * and they don't allocate memory: the writer fills the buffer that is not published nor read, and it swaps it with
+ * the published one, and the reader swaps the published buffer with the one it was reading if there is a newer one.
+ * There has to be a single writer thread and a single reader thread.
+ */
+class PolicyPublisher : public CallbackAbstract {
+ public:
+  PolicyPublisher(SolverDDP& solver, const double& dt);
+  ~PolicyPublisher();
+
+  void operator()(SolverAbstract& solver);
+  /**
+   * @brief Copy the current policy of the solver into the published buffer (writer thread)
+   */
+  void publish();
+  /**
+   * @brief Return the last published policy (reader thread)
+   *
+   * The returned snapshot is not modified until the next call of read.
+   */
+  const PolicySnapshot& read();
+  /**
+   * @brief Return true if a policy was published after the last read
+   */
+  bool has_update() const;
+
+  const double& get_time() const;
+  const double& get_dt() const;
+  /**
+   * @brief Set the time of the initial state of the problem, which is the time of the first node of the policy
+   */
+  void set_time(const double& time);
+  void set_dt(const double& dt);
+
+ private:
+  static const unsigned char UPDATED = 4;  //!< flag of the published index, set until the reader takes it
+
+  SolverDDP& solver_;
+  PolicySnapshot buffers_[3];
+  boost::atomic<unsigned char> published_;  //!< index of the published buffer and UPDATED flag
+  unsigned char back_;                      //!< buffer written by the writer
+  unsigned char front_;                     //!< buffer read by the reader
+  double time_;
+  double dt_;
+  unsigned long sequence_;
+};
+
+/**
+ * @brief Evaluate a policy at a given time and state without allocating memory
+ *
+ * The controls are linearly interpolated between the policies of the two nodes around the given time, and the
+ * policy of the first (last) node is applied before (after) the horizon.
+ */
+class PolicyEvaluator {
+ public:
+  explicit PolicyEvaluator(ShootingProblem& problem);
+  ~PolicyEvaluator();
+
+  void evaluate(const PolicySnapshot& policy, const double& time, const Eigen::Ref<const Eigen::VectorXd>& x,
+                Eigen::Ref<Eigen::VectorXd> u);
+
+ private:
+  void evaluateNode(const PolicySnapshot& policy, const std::size_t& t, const Eigen::Ref<const Eigen::VectorXd>& x,
+                    Eigen::Ref<Eigen::VectorXd> u);
+
+  std::vector<StateAbstract*> states_;
+  std::vector<Eigen::VectorXd> dx_;
+  std::vector<Eigen::VectorXd> u_;
+};
+
+}  // namespace crocoddyl
+
+#endif  // CROCODDYL_CORE_UTILS_POLICY_HPP_
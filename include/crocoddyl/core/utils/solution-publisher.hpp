@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_CORE_UTILS_SOLUTION_PUBLISHER_HPP_
+#define CROCODDYL_CORE_UTILS_SOLUTION_PUBLISHER_HPP_
+
+#include <string>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include "crocoddyl/core/solver-base.hpp"
+
+namespace crocoddyl {
+
+/**
+ * @brief Header of the shared-memory ring of solutions
+ *
+ * The segment is the header followed by capacity slots of slot_size bytes, both aligned to cache lines. Each slot is a
+ * SolutionSlot followed by the states (nxs doubles, i.e. the states of the nodes stacked) and the controls (nus
+ * doubles).
+ */
+struct SolutionRing {
+  boost::uint32_t magic;
+  boost::uint32_t version;
+  boost::uint32_t T;
+  boost::uint32_t nxs;
+  boost::uint32_t nus;
+  boost::uint32_t capacity;
+  boost::uint64_t slot_size;
+  boost::atomic<boost::uint64_t> published;  //!< number of published solutions
+};
+
+/**
+ * @brief Iteration stats of a published solution
+ */
+struct SolutionStats {
+  boost::uint64_t index;  //!< number of the publication
+  double cost;
+  double stop;
+  double xreg;
+  double ureg;
+  double steplength;
+  double dV;
+  double dVexp;
+  boost::uint32_t iter;
+  boost::uint32_t feasible;
+};
+
+/**
+ * @brief Slot of the ring, which is protected by a seqlock, i.e. its sequence is odd while it is written
+ */
+struct SolutionSlot {
+  boost::atomic<boost::uint64_t> sequence;
+  SolutionStats stats;
+};
+
+/**
+ * @brief Publish the accepted solutions of a solver in a POSIX shared-memory ring
+ *
+ * As a callback, it copies the candidate and the iteration stats after each iteration that accepted a step. The
+ * writer never waits for the readers: it writes the next slot of the ring under a seqlock, and the readers retry
+ * (or skip) a slot that is overwritten while they copy it. The segment is created at construction and removed at
+ * destruction. A previous segment with the same name is unlinked rather than truncated, so the readers that still map
+ * it aren't affected. If it cannot be created, a warning is printed and nothing is published.
+ */
+class SolutionPublisher : public CallbackAbstract {
+ public:
+  SolutionPublisher(const std::string& name, const ShootingProblem& problem, const std::size_t& capacity = 16);
+  ~SolutionPublisher();
+
+  void operator()(SolverAbstract& solver);
+  /**
+   * @brief Copy the candidate and iteration stats of the solver into the next slot of the ring
+   */
+  void publish(const SolverAbstract& solver);
+
+  bool is_open() const;
+  const std::string& get_name() const;
+  const std::size_t& get_capacity() const;
+  boost::uint64_t get_published() const;
+
+ private:
+  std::string name_;
+  std::size_t capacity_;
+  std::size_t size_;  //!< size of the segment [bytes]
+  SolutionRing* ring_;
+};
+
+/**
+ * @brief Read the solutions published by a SolutionPublisher, e.g. from another process
+ *
+ * It maps the segment read-only and copies the solutions out of it, so it never blocks the publisher.
+ */
+class SolutionReader {
+ public:
+  explicit SolutionReader(const std::string& name);
+  ~SolutionReader();
+
+  /**
+   * @brief Copy the last published solution, and return false if there is none (or if it couldn't be copied)
+   */
+  bool read_last(SolutionStats& stats, Eigen::VectorXd& xs, Eigen::VectorXd& us) const;
+  /**
+   * @brief Copy a published solution by its index, and return false if it was already overwritten
+   */
+  bool read(const boost::uint64_t& index, SolutionStats& stats, Eigen::VectorXd& xs, Eigen::VectorXd& us) const;
+
+  bool is_open() const;
+  boost::uint64_t get_published() const;
+  unsigned int get_T() const;
+  unsigned int get_nxs() const;
+  unsigned int get_nus() const;
+  unsigned int get_capacity() const;
+
+ private:
+  std::size_t size_;
+  const SolutionRing* ring_;
+};
+
+}  // namespace crocoddyl
+
+#endif  // CROCODDYL_CORE_UTILS_SOLUTION_PUBLISHER_HPP_
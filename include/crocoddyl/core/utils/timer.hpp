@@ -0,0 +1,44 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_CORE_UTILS_TIMER_HPP_
+#define CROCODDYL_CORE_UTILS_TIMER_HPP_
+
+#include <time.h>
+
+namespace crocoddyl {
+
+/**
+ * @brief Wall-clock stopwatch
+ *
+ * It reads the monotonic clock, so it measures the elapsed time (and not the CPU time of the process as std::clock
+ * does) and it is not affected by changes of the system time.
+ */
+class Timer {
+ public:
+  Timer() { reset(); }
+
+  void reset() { clock_gettime(CLOCK_MONOTONIC, &start_); }
+
+  /**
+   * @brief Return the elapsed time since the last reset in milliseconds
+   */
+  double get_duration() const {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return 1e3 * static_cast<double>(now.tv_sec - start_.tv_sec) +
+           1e-6 * static_cast<double>(now.tv_nsec - start_.tv_nsec);
+  }
+
+ private:
+  timespec start_;
+};
+
+}  // namespace crocoddyl
+
+#endif  // CROCODDYL_CORE_UTILS_TIMER_HPP_
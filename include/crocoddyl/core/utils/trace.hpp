@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef CROCODDYL_CORE_UTILS_TRACE_HPP_
+#define CROCODDYL_CORE_UTILS_TRACE_HPP_
+
+#include <time.h>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <boost/atomic.hpp>
+
+namespace crocoddyl {
+
+/**
+ * @brief Evaluation recorded by the trace recorder
+ *
+ * The strings are not copied, so they have to outlive the recorder's dump. They are either string literals or the
+ * names of the cost and contact items.
+ */
+struct TraceEvent {
+  const char* category;  //!< e.g. "action", "cost" or "contact"
+  const char* name;      //!< e.g. "calc" for an action or the name of a cost item
+  const char* function;  //!< evaluated function (e.g. "calcDiff"), or NULL if it is already the name
+  int node;              //!< node of the shooting problem, or -1 if it is unknown
+  int thread;
+  double start;     //!< [us] since the recorder was cleared
+  double duration;  //!< [us]
+};
+
+/**
+ * @brief Recorder of the model evaluations in the Chrome trace format
+ *
+ * The events are stored in a buffer that is allocated once, and each event reserves its slot with an atomic
+ * increment. So recording is lock free and the actions of a problem can be traced while they are evaluated in parallel.
+ * Once the buffer is full, the next events are dropped (and counted). The buffer is dumped as a Chrome trace JSON,
+ * which can be opened in chrome://tracing or Perfetto. Both clear and dump have to be called when no evaluation is
+ * being recorded.
+ *
+ * The library records the events only if it was built with CROCODDYL_WITH_TRACE, otherwise the CROCODDYL_TRACE_SCOPE
+ * macro is empty and tracing has no overhead.
+ */
+class TraceRecorder {
+ public:
+  explicit TraceRecorder(const std::size_t& capacity = 65536);
+  ~TraceRecorder();
+
+  /**
+   * @brief Return the recorder used by the library
+   */
+  static TraceRecorder& get_instance();
+
+  void record(const char* category, const char* name, const char* function, const int& node, const double& start,
+              const double& duration);
+  void clear();
+  void dump(std::ostream& os) const;
+  void dump(const std::string& filename) const;
+
+  /**
+   * @brief Return the current time [us] since the recorder was cleared
+   */
+  double now() const;
+
+  const bool& get_enabled() const;
+  std::size_t get_size() const;
+  std::size_t get_capacity() const;
+  std::size_t get_dropped() const;
+  const std::vector<TraceEvent>& get_events() const;
+  void set_enabled(const bool& enabled);
+  void set_capacity(const std::size_t& capacity);
+
+ private:
+  std::vector<TraceEvent> events_;
+  boost::atomic<std::size_t> size_;
+  bool enabled_;
+  timespec origin_;
+};
+
+/**
+ * @brief Record the lifetime of the scope as an event of the library's recorder
+ */
+class TraceScope {
+ public:
+  TraceScope(const char* category, const char* name, const char* function = NULL, const int& node = -1)
+      : recorder_(TraceRecorder::get_instance()), category_(category), name_(name), function_(function), node_(node) {
+    if (recorder_.get_enabled()) {
+      start_ = recorder_.now();
+    }
+  }
+  ~TraceScope() {
+    if (recorder_.get_enabled()) {
+      recorder_.record(category_, name_, function_, node_, start_, recorder_.now() - start_);
+    }
+  }
+
+ private:
+  TraceRecorder& recorder_;
+  const char* category_;
+  const char* name_;
+  const char* function_;
+  int node_;
+  double start_;
+};
+
+}  // namespace crocoddyl
+
+#ifdef CROCODDYL_WITH_TRACE
+#define CROCODDYL_TRACE_CONCAT_(a, b) a##b
+#define CROCODDYL_TRACE_CONCAT(a, b) CROCODDYL_TRACE_CONCAT_(a, b)
+#define CROCODDYL_TRACE_SCOPE(category, name, function, node) \
+  crocoddyl::TraceScope CROCODDYL_TRACE_CONCAT(crocoddyl_trace_scope_, __LINE__)(category, name, function, node)
+#else
+#define CROCODDYL_TRACE_SCOPE(category, name, function, node)
+#endif
+
+#endif  // CROCODDYL_CORE_UTILS_TRACE_HPP_
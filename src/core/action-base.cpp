@@ -8,6 +8,7 @@
 
 #include "crocoddyl/core/action-base.hpp"
 #include <iostream>
+#include <cmath>
 namespace crocoddyl {
 
 ActionModelAbstract::ActionModelAbstract(StateAbstract& state, unsigned int const& nu, unsigned int const& nr)
@@ -23,8 +24,8 @@ void ActionModelAbstract::calc(const boost::shared_ptr<ActionDataAbstract>& data
 }
 
 void ActionModelAbstract::calcDiff(const boost::shared_ptr<ActionDataAbstract>& data,
-                                   const Eigen::Ref<const Eigen::VectorXd>& x) {
-  calcDiff(data, x, unone_);
+                                   const Eigen::Ref<const Eigen::VectorXd>& x, const bool& recalc) {
+  calcDiff(data, x, unone_, recalc);
 }
 
 void ActionModelAbstract::quasicStatic(const boost::shared_ptr<ActionDataAbstract>& data,
@@ -33,15 +34,25 @@ void ActionModelAbstract::quasicStatic(const boost::shared_ptr<ActionDataAbstrac
   assert(u.size() == nu_ && "u has wrong dimension");
   assert(x.size() == state_.get_nx() && "x has wrong dimension");
 
-  unsigned int const& ndx = state_.get_ndx();
-  Eigen::VectorXd dx = Eigen::VectorXd::Zero(ndx);
-  Eigen::VectorXd du = Eigen::VectorXd::Zero(nu_);
+  // du = -pinv(Fu) * Fx * dx, computed through the preallocated SVD of Fu and with the pseudoInverse tolerance. Only
+  // the first columns of U and V are paired with singular values
+  const double eps = std::numeric_limits<double>::epsilon();
   for (unsigned int i = 0; i < maxiter; ++i) {
     calcDiff(data, x, u);
-    state_.diff(x, data->xnext, dx);
-    du = -pseudoInverse(data->Fu) * data->Fx * dx;
-    u += du;
-    if (du.norm() <= tol) {
+    state_.diff(x, data->xnext, data->qs_dx);
+    data->qs_Fxdx.noalias() = data->Fx * data->qs_dx;
+    data->Fu_svd.compute(data->Fu, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    const Eigen::VectorXd& s = data->Fu_svd.singularValues();
+    // Without controls (or state) there are no singular values, and so there is nothing to invert
+    const double smax = s.size() > 0 ? std::abs(s(0)) : 0.;
+    const double tolerance = eps * static_cast<double>(std::max(data->Fu.rows(), data->Fu.cols())) * smax;
+    data->qs_y.noalias() = data->Fu_svd.matrixU().leftCols(s.size()).transpose() * data->qs_Fxdx;
+    for (Eigen::Index j = 0; j < s.size(); ++j) {
+      data->qs_y(j) = std::abs(s(j)) > tolerance ? data->qs_y(j) / s(j) : 0.;
+    }
+    data->qs_du.noalias() = -data->Fu_svd.matrixV().leftCols(s.size()) * data->qs_y;
+    u += data->qs_du;
+    if (data->qs_du.norm() <= tol) {
       break;
     }
   }
@@ -7,23 +7,13 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "crocoddyl/core/numdiff/state.hpp"
+#include <boost/make_shared.hpp>
 
 namespace crocoddyl {
 
-StateNumDiff::StateNumDiff(StateAbstract& state) : StateAbstract(state.get_nx(), state.get_ndx()), state_(state) {
-  disturbance_ = 1e-6;
-  // disturbance vector
-  dx_.resize(ndx_);
-  dx_.setZero();
-  // State around which to compute the finite integrate-operator jacobians
-  x0_.resize(nx_);
-  x0_.setZero();
-  // State difference around which to compute the finite difference-operator jacobians
-  dx0_.resize(ndx_);
-  dx0_.setZero();
-  // temporary variable needed
-  tmp_x_.resize(nx_);
-  tmp_x_.setZero();
+StateNumDiff::StateNumDiff(StateAbstract& state)
+    : StateAbstract(state.get_nx(), state.get_ndx()), state_(state), disturbance_(1e-6) {
+  data_ = createData();
 }
 
 StateNumDiff::~StateNumDiff() {}
@@ -51,25 +41,44 @@ void StateNumDiff::integrate(const Eigen::Ref<const Eigen::VectorXd>& x, const E
 void StateNumDiff::Jdiff(const Eigen::Ref<const Eigen::VectorXd>& x0, const Eigen::Ref<const Eigen::VectorXd>& x1,
                          Eigen::Ref<Eigen::MatrixXd> Jfirst, Eigen::Ref<Eigen::MatrixXd> Jsecond,
                          Jcomponent firstsecond) {
+  Jdiff(data_, x0, x1, Jfirst, Jsecond, firstsecond);
+}
+
+void StateNumDiff::Jintegrate(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& dx,
+                              Eigen::Ref<Eigen::MatrixXd> Jfirst, Eigen::Ref<Eigen::MatrixXd> Jsecond,
+                              Jcomponent firstsecond) {
+  Jintegrate(data_, x, dx, Jfirst, Jsecond, firstsecond);
+}
+
+void StateNumDiff::Jdiff(const boost::shared_ptr<StateDataNumDiff>& data, const Eigen::Ref<const Eigen::VectorXd>& x0,
+                         const Eigen::Ref<const Eigen::VectorXd>& x1, Eigen::Ref<Eigen::MatrixXd> Jfirst,
+                         Eigen::Ref<Eigen::MatrixXd> Jsecond, Jcomponent firstsecond) {
   assert(is_a_Jcomponent(firstsecond) && ("firstsecond must be one of the Jcomponent {both, first, second}"));
   assert(x0.size() == nx_ && "x0 has wrong dimension");
   assert(x1.size() == nx_ && "x1 has wrong dimension");
 
-  dx_.setZero();
-  diff(x0, x1, dx0_);
+  // disturbance vector
+  Eigen::VectorXd& dx = data->dx;
+  // state difference around which to compute the finite difference-operator jacobians
+  Eigen::VectorXd& dx0 = data->dx0;
+  // temporary variable needed
+  Eigen::VectorXd& tmp_x = data->tmp_x;
+
+  dx.setZero();
+  diff(x0, x1, dx0);
   if (firstsecond == first || firstsecond == both) {
     assert(Jfirst.rows() == ndx_ && Jfirst.cols() == ndx_ && "Jfirst must be of the good size");
     Jfirst.setZero();
     for (unsigned int i = 0; i < ndx_; ++i) {
-      dx_(i) = disturbance_;
+      dx(i) = disturbance_;
       // tmp_x = int(x0, dx)
-      integrate(x0, dx_, tmp_x_);
+      integrate(x0, dx, tmp_x);
       // Jfirst[:,k] = diff(tmp_x, x1) = diff(int(x0 + dx), x1)
-      diff(tmp_x_, x1, Jfirst.col(i));
-      // Jfirst[:,k] = Jfirst[:,k] - tmp_dx_, or
+      diff(tmp_x, x1, Jfirst.col(i));
+      // Jfirst[:,k] = Jfirst[:,k] - tmp_dx, or
       // Jfirst[:,k] = Jfirst[:,k] - diff(x0, x1)
-      Jfirst.col(i) -= dx0_;
-      dx_(i) = 0.0;
+      Jfirst.col(i) -= dx0;
+      dx(i) = 0.0;
     }
     Jfirst /= disturbance_;
   }
@@ -78,21 +87,22 @@ void StateNumDiff::Jdiff(const Eigen::Ref<const Eigen::VectorXd>& x0, const Eige
 
     Jsecond.setZero();
     for (unsigned int i = 0; i < ndx_; ++i) {
-      dx_(i) = disturbance_;
+      dx(i) = disturbance_;
       // tmp_x = int(x1 + dx)
-      integrate(x1, dx_, tmp_x_);
+      integrate(x1, dx, tmp_x);
       // Jsecond[:,k] = diff(x0, tmp_x) = diff(x0, int(x1 + dx))
-      diff(x0, tmp_x_, Jsecond.col(i));
+      diff(x0, tmp_x, Jsecond.col(i));
       // Jsecond[:,k] = J[:,k] - tmp_dx_
       // Jsecond[:,k] = Jsecond[:,k] - diff(x0, x1)
-      Jsecond.col(i) -= dx0_;
-      dx_(i) = 0.0;
+      Jsecond.col(i) -= dx0;
+      dx(i) = 0.0;
     }
     Jsecond /= disturbance_;
   }
 }
 
-void StateNumDiff::Jintegrate(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& dx,
+void StateNumDiff::Jintegrate(const boost::shared_ptr<StateDataNumDiff>& data,
+                              const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& dx,
                               Eigen::Ref<Eigen::MatrixXd> Jfirst, Eigen::Ref<Eigen::MatrixXd> Jsecond,
                               Jcomponent firstsecond) {
   assert((firstsecond == first || firstsecond == second || firstsecond == both) &&
@@ -100,23 +110,32 @@ void StateNumDiff::Jintegrate(const Eigen::Ref<const Eigen::VectorXd>& x, const
   assert(x.size() == nx_ && "x has wrong dimension");
   assert(dx.size() == ndx_ && "dx has wrong dimension");
 
-  dx_.setZero();
-  // x0_ = integrate(x, dx)
-  integrate(x, dx, x0_);
+  // disturbance vector
+  Eigen::VectorXd& dx_dist = data->dx;
+  // state around which to compute the finite integrate-operator jacobians
+  Eigen::VectorXd& x0 = data->x0;
+  // temporary variables needed
+  Eigen::VectorXd& tmp_x = data->tmp_x;
+  Eigen::VectorXd& tmp_x0 = data->tmp_x0;
+  Eigen::VectorXd& tmp_dx = data->tmp_dx;
+
+  dx_dist.setZero();
+  // x0 = integrate(x, dx)
+  integrate(x, dx, x0);
 
   if (firstsecond == first || firstsecond == both) {
     assert(Jfirst.rows() == ndx_ && Jfirst.cols() == ndx_ && "Jfirst must be of the good size");
     Jfirst.setZero();
     for (unsigned int i = 0; i < ndx_; ++i) {
-      dx_(i) = disturbance_;
-      // tmp_x_ = integrate(x, dx_) = integrate(x, disturbance_vector)
-      integrate(x, dx_, tmp_x_);
-      // tmp_x_ = integrate(tmp_x_, dx) = integrate(integrate(x, dx_), dx)
-      integrate(tmp_x_, dx, tmp_x_);
-      // Jfirst[:,i] = diff(x0_, tmp_x_)
-      // Jfirst[:,i] = diff( integrate(x, dx), integrate(integrate(x, dx_), dx))
-      diff(x0_, tmp_x_, Jfirst.col(i));
-      dx_(i) = 0.0;
+      dx_dist(i) = disturbance_;
+      // tmp_x = integrate(x, dx_dist) = integrate(x, disturbance_vector)
+      integrate(x, dx_dist, tmp_x);
+      // tmp_x0 = integrate(tmp_x, dx) = integrate(integrate(x, dx_dist), dx)
+      integrate(tmp_x, dx, tmp_x0);
+      // Jfirst[:,i] = diff(x0, tmp_x0)
+      // Jfirst[:,i] = diff( integrate(x, dx), integrate(integrate(x, dx_dist), dx))
+      diff(x0, tmp_x0, Jfirst.col(i));
+      dx_dist(i) = 0.0;
     }
     Jfirst /= disturbance_;
   }
@@ -124,16 +143,20 @@ void StateNumDiff::Jintegrate(const Eigen::Ref<const Eigen::VectorXd>& x, const
     assert(Jsecond.rows() == ndx_ && Jsecond.cols() == ndx_ && "Jfirst must be of the good size");
     Jsecond.setZero();
     for (unsigned int i = 0; i < ndx_; ++i) {
-      dx_(i) = disturbance_;
-      // tmp_x_ = integrate(x, dx + dx_) = integrate(x, dx + disturbance_vector)
-      integrate(x, dx + dx_, tmp_x_);
-      // Jsecond[:,i] = diff(x0_, tmp_x_)
-      // Jsecond[:,i] = diff( integrate(x, dx), integrate(x, dx_ + dx) )
-      diff(x0_, tmp_x_, Jsecond.col(i));
-      dx_(i) = 0.0;
+      dx_dist(i) = disturbance_;
+      // tmp_dx = dx + dx_dist = dx + disturbance_vector
+      tmp_dx = dx + dx_dist;
+      // tmp_x0 = integrate(x, tmp_dx)
+      integrate(x, tmp_dx, tmp_x0);
+      // Jsecond[:,i] = diff(x0, tmp_x0)
+      // Jsecond[:,i] = diff( integrate(x, dx), integrate(x, dx_dist + dx) )
+      diff(x0, tmp_x0, Jsecond.col(i));
+      dx_dist(i) = 0.0;
     }
     Jsecond /= disturbance_;
   }
 }
 
+boost::shared_ptr<StateDataNumDiff> StateNumDiff::createData() { return boost::make_shared<StateDataNumDiff>(this); }
+
 }  // namespace crocoddyl
@@ -7,16 +7,32 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "crocoddyl/core/optctrl/shooting.hpp"
+#include "crocoddyl/core/utils/trace.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
 
 namespace crocoddyl {
 
+namespace {
+
+bool isClose(const Eigen::VectorXd& a, const Eigen::VectorXd& b, const double& tol) {
+  return a.size() == b.size() && (a.size() == 0 || (a - b).lpNorm<Eigen::Infinity>() <= tol);
+}
+
+}  // namespace
+
 ShootingProblem::ShootingProblem(const Eigen::VectorXd& x0, const std::vector<ActionModelAbstract*>& running_models,
                                  ActionModelAbstract* const terminal_model)
     : terminal_model_(terminal_model),
       running_models_(running_models),
       T_(static_cast<unsigned int>(running_models.size())),
       x0_(x0),
-      cost_(0.) {
+      nthreads_(1),
+      cost_(0.),
+      lin_tol_(std::numeric_limits<double>::quiet_NaN()),
+      nreused_(0) {
   assert(x0_.size() == running_models_[0]->get_state().get_nx() && "x0 has wrong dimension");
   allocateData();
 }
@@ -27,36 +43,82 @@ double ShootingProblem::calc(const std::vector<Eigen::VectorXd>& xs, const std::
   assert(xs.size() == T_ + 1 && "Wrong dimension of the state trajectory, it should be T + 1.");
   assert(us.size() == T_ && "Wrong dimension of the control trajectory, it should be T.");
 
+  // Nodes are independent, and their cost differs a lot (e.g. contact vs free-flight phases). So we let each thread
+  // grab the next available node (dynamic schedule) instead of splitting the horizon into equal chunks.
+  const int T = static_cast<int>(T_);
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for num_threads(nthreads_) schedule(dynamic)
+#endif
+  for (int i = 0; i < T; ++i) {
+    CROCODDYL_TRACE_SCOPE("action", "calc", NULL, i);
+    running_models_[i]->calc(running_datas_[i], xs[i], us[i]);
+  }
+  {
+    CROCODDYL_TRACE_SCOPE("action", "calc", NULL, T);
+    terminal_model_->calc(terminal_data_, xs.back());
+  }
+
+  // The cost is reduced in node order, so its value does not depend on the number of threads
   cost_ = 0;
   for (unsigned int i = 0; i < T_; ++i) {
-    ActionModelAbstract* model = running_models_[i];
-    boost::shared_ptr<ActionDataAbstract>& data = running_datas_[i];
-    const Eigen::VectorXd& x = xs[i];
-    const Eigen::VectorXd& u = us[i];
-
-    model->calc(data, x, u);
-    cost_ += data->cost;
+    cost_ += running_datas_[i]->cost;
   }
-  terminal_model_->calc(terminal_data_, xs.back());
   cost_ += terminal_data_->cost;
   return cost_;
 }
 
-double ShootingProblem::calcDiff(const std::vector<Eigen::VectorXd>& xs, const std::vector<Eigen::VectorXd>& us) {
+double ShootingProblem::calcDiff(const std::vector<Eigen::VectorXd>& xs, const std::vector<Eigen::VectorXd>& us,
+                                 const bool& recalc) {
   assert(xs.size() == T_ + 1 && "Wrong dimension of the state trajectory, it should be T + 1.");
   assert(us.size() == T_ && "Wrong dimension of the control trajectory, it should be T.");
 
-  cost_ = 0;
-  for (unsigned int i = 0; i < T_; ++i) {
+  const int T = static_cast<int>(T_);
+  const bool lazy = !std::isnan(lin_tol_);
+  int nreused = 0;
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for num_threads(nthreads_) schedule(dynamic) reduction(+ : nreused)
+#endif
+  for (int i = 0; i < T; ++i) {
     ActionModelAbstract* model = running_models_[i];
     boost::shared_ptr<ActionDataAbstract>& data = running_datas_[i];
-    const Eigen::VectorXd& x = xs[i];
-    const Eigen::VectorXd& u = us[i];
+    if (lazy && isLinearizedAt(i, xs, us)) {
+      if (recalc) {
+        CROCODDYL_TRACE_SCOPE("action", "calc", NULL, i);
+        model->calc(data, xs[i], us[i]);
+      }
+      ++nreused;
+      continue;
+    }
+    CROCODDYL_TRACE_SCOPE("action", "calcDiff", NULL, i);
+    model->calcDiff(data, xs[i], us[i], recalc);
+    if (lazy) {
+      lin_xs_[i] = xs[i];
+      lin_us_[i] = us[i];
+      lin_models_[i] = model;
+      lin_datas_[i] = data.get();
+    }
+  }
+  if (lazy && isLinearizedAt(T_, xs, us)) {
+    if (recalc) {
+      CROCODDYL_TRACE_SCOPE("action", "calc", NULL, T);
+      terminal_model_->calc(terminal_data_, xs.back());
+    }
+    ++nreused;
+  } else {
+    CROCODDYL_TRACE_SCOPE("action", "calcDiff", NULL, T);
+    terminal_model_->calcDiff(terminal_data_, xs.back(), recalc);
+    if (lazy) {
+      lin_xs_[T_] = xs.back();
+      lin_models_[T_] = terminal_model_;
+      lin_datas_[T_] = terminal_data_.get();
+    }
+  }
+  nreused_ = static_cast<unsigned int>(nreused);
 
-    model->calcDiff(data, x, u);
-    cost_ += data->cost;
+  cost_ = 0;
+  for (unsigned int i = 0; i < T_; ++i) {
+    cost_ += running_datas_[i]->cost;
   }
-  terminal_model_->calcDiff(terminal_data_, xs.back());
   cost_ += terminal_data_->cost;
   return cost_;
 }
@@ -84,18 +146,89 @@ std::vector<Eigen::VectorXd> ShootingProblem::rollout_us(const std::vector<Eigen
   return xs;
 }
 
+void ShootingProblem::circularAppend(ActionModelAbstract* model, const boost::shared_ptr<ActionDataAbstract>& data) {
+  assert(T_ > 0 && "The problem has to have running nodes");
+  assert(model->get_state().get_nx() == running_models_.back()->get_state().get_nx() && "model has wrong dimension");
+  // The data could be one of the running datas, so we hold it before rotating the nodes
+  const boost::shared_ptr<ActionDataAbstract> d = data;
+  std::rotate(running_models_.begin(), running_models_.begin() + 1, running_models_.end());
+  std::rotate(running_datas_.begin(), running_datas_.begin() + 1, running_datas_.end());
+  running_models_.back() = model;
+  running_datas_.back() = d;
+
+  // The linearization points follow their nodes, and the appended node has to be linearized
+  std::rotate(lin_xs_.begin(), lin_xs_.begin() + 1, lin_xs_.begin() + T_);
+  std::rotate(lin_us_.begin(), lin_us_.begin() + 1, lin_us_.begin() + T_);
+  std::rotate(lin_models_.begin(), lin_models_.begin() + 1, lin_models_.begin() + T_);
+  std::rotate(lin_datas_.begin(), lin_datas_.begin() + 1, lin_datas_.begin() + T_);
+  lin_datas_[T_ - 1] = NULL;
+}
+
+void ShootingProblem::invalidateLinearization(const unsigned int& i) {
+  assert(i <= T_ && "The node has to be between 0 and T");
+  lin_datas_[i] = NULL;
+}
+
+void ShootingProblem::invalidateLinearizations() {
+  std::fill(lin_datas_.begin(), lin_datas_.end(), static_cast<const ActionDataAbstract*>(NULL));
+}
+
 unsigned int ShootingProblem::get_T() const { return T_; }
 
 const Eigen::VectorXd& ShootingProblem::get_x0() const { return x0_; }
 
+void ShootingProblem::set_x0(const Eigen::VectorXd& x0) {
+  assert(x0.size() == x0_.size() && "x0 has wrong dimension");
+  x0_ = x0;
+}
+
+const unsigned int& ShootingProblem::get_nthreads() const { return nthreads_; }
+
+void ShootingProblem::set_nthreads(const unsigned int& nthreads) {
+  assert(nthreads > 0 && "The number of threads has to be positive");
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  nthreads_ = nthreads == 0 ? 1 : nthreads;
+#else
+  if (nthreads != 1) {
+    std::cout << "Warning: crocoddyl was built without multithreading support, we cannot set nthreads" << std::endl;
+  }
+#endif  // CROCODDYL_WITH_MULTITHREADING
+}
+
 void ShootingProblem::allocateData() {
   for (unsigned int i = 0; i < T_; ++i) {
     ActionModelAbstract* model = running_models_[i];
     running_datas_.push_back(model->createData());
+    lin_xs_.push_back(Eigen::VectorXd::Zero(model->get_state().get_nx()));
+    lin_us_.push_back(Eigen::VectorXd::Zero(model->get_nu()));
   }
   terminal_data_ = terminal_model_->createData();
+  lin_xs_.push_back(Eigen::VectorXd::Zero(terminal_model_->get_state().get_nx()));
+  lin_us_.push_back(Eigen::VectorXd());
+  lin_models_.resize(T_ + 1, NULL);
+  lin_datas_.resize(T_ + 1, NULL);
+}
+
+bool ShootingProblem::isLinearizedAt(const unsigned int& i, const std::vector<Eigen::VectorXd>& xs,
+                                     const std::vector<Eigen::VectorXd>& us) const {
+  if (i == T_) {
+    return lin_datas_[i] == terminal_data_.get() && lin_models_[i] == terminal_model_ &&
+           isClose(xs[i], lin_xs_[i], lin_tol_);
+  }
+  return lin_datas_[i] == running_datas_[i].get() && lin_models_[i] == running_models_[i] &&
+         isClose(xs[i], lin_xs_[i], lin_tol_) && isClose(us[i], lin_us_[i], lin_tol_);
 }
 
+const double& ShootingProblem::get_relinearization_tolerance() const { return lin_tol_; }
+
+void ShootingProblem::set_relinearization_tolerance(const double& tol) {
+  assert((std::isnan(tol) || tol >= 0.) && "The tolerance has to be positive or NaN");
+  lin_tol_ = tol;
+  invalidateLinearizations();
+}
+
+const unsigned int& ShootingProblem::get_nreused() const { return nreused_; }
+
 std::vector<ActionModelAbstract*>& ShootingProblem::get_runningModels() { return running_models_; }
 
 ActionModelAbstract* ShootingProblem::get_terminalModel() { return terminal_model_; }
@@ -7,12 +7,16 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "crocoddyl/core/solver-base.hpp"
+#include <algorithm>
+#include <limits>
+#include <boost/make_shared.hpp>
 
 namespace crocoddyl {
 
 SolverAbstract::SolverAbstract(ShootingProblem& problem)
     : problem_(problem),
       is_feasible_(false),
+      is_accepted_(false),
       cost_(0.),
       stop_(0.),
       xreg_(NAN),
@@ -22,10 +26,19 @@ SolverAbstract::SolverAbstract(ShootingProblem& problem)
       dVexp_(0.),
       th_acceptstep_(0.1),
       th_stop_(1e-9),
-      iter_(0) {
+      iter_(0),
+      status_(SolverStatusSuccess),
+      failed_node_(-1),
+      time_budget_(std::numeric_limits<double>::infinity()),
+      stopped_by_budget_(false),
+      history_(boost::make_shared<HistoryMatrix>(HistoryMatrix::Zero(256, SolverHistoryNbFields))),
+      history_size_(0) {
+  std::fill(phase_times_, phase_times_ + 4, 0.);
+
   // Allocate common data
   const unsigned int& T = problem_.get_T();
   xs_.resize(T + 1);
+  xs_zero_.resize(T + 1);
   us_.resize(T);
   models_.resize(T + 1);
   datas_.resize(T + 1);
@@ -34,12 +47,14 @@ SolverAbstract::SolverAbstract(ShootingProblem& problem)
     boost::shared_ptr<ActionDataAbstract>& data = problem_.running_datas_[t];
     const int& nu = model->get_nu();
 
-    xs_[t] = model->get_state().zero();
+    xs_zero_[t] = model->get_state().zero();
+    xs_[t] = xs_zero_[t];
     us_[t] = Eigen::VectorXd::Zero(nu);
     models_[t] = model;
     datas_[t] = data;
   }
-  xs_.back() = problem_.terminal_model_->get_state().zero();
+  xs_zero_.back() = problem_.terminal_model_->get_state().zero();
+  xs_.back() = xs_zero_.back();
   models_.back() = problem_.terminal_model_;
   datas_.back() = problem_.terminal_data_;
 }
@@ -51,29 +66,83 @@ void SolverAbstract::setCandidate(const std::vector<Eigen::VectorXd>& xs_warm,
   const unsigned int& T = problem_.get_T();
 
   if (xs_warm.size() == 0) {
-    for (unsigned int t = 0; t < T; ++t) {
-      xs_[t] = problem_.running_models_[t]->get_state().zero();
-    }
-    xs_.back() = problem_.terminal_model_->get_state().zero();
+    // Copying the cached zero states, as StateAbstract::zero returns a new vector
+    std::copy(xs_zero_.begin(), xs_zero_.end(), xs_.begin());
   } else {
     assert(xs_warm.size() == T + 1);
-    std::copy(xs_warm.begin(), xs_warm.end(), xs_.begin());
+    // There is nothing to copy when warm-starting from the current candidate
+    if (&xs_warm != &xs_) {
+      std::copy(xs_warm.begin(), xs_warm.end(), xs_.begin());
+    }
   }
 
   if (us_warm.size() == 0) {
     for (unsigned int t = 0; t < T; ++t) {
-      const int& nu = problem_.running_models_[t]->get_nu();
-      us_[t] = Eigen::VectorXd::Zero(nu);
+      us_[t].setZero();
     }
   } else {
     assert(us_warm.size() == T);
-    std::copy(us_warm.begin(), us_warm.end(), us_.begin());
+    if (&us_warm != &us_) {
+      std::copy(us_warm.begin(), us_warm.end(), us_.begin());
+    }
   }
   is_feasible_ = is_feasible;
 }
 
+void SolverAbstract::shiftHorizon(ActionModelAbstract* model, const boost::shared_ptr<ActionDataAbstract>& data) {
+  assert(model->get_nu() == problem_.running_models_.back()->get_nu() && "model has wrong control dimension");
+  const bool is_recycled = model == problem_.running_models_[0];
+  problem_.circularAppend(model, data);
+  shiftCandidate();
+
+  // Updating the nodes of the solver once the derived solvers have rotated their buffers
+  const unsigned int& T = problem_.get_T();
+  for (unsigned int t = 0; t < T; ++t) {
+    models_[t] = problem_.running_models_[t];
+    datas_[t] = problem_.running_datas_[t];
+  }
+  for (unsigned int t = 0; t + 1 < T; ++t) {
+    xs_zero_[t].swap(xs_zero_[t + 1]);
+  }
+  if (!is_recycled) {
+    xs_zero_[T - 1] = model->get_state().zero();
+  }
+}
+
+void SolverAbstract::shiftHorizon() {
+  // We hold the first node as the rotation overwrites it
+  ActionModelAbstract* model = problem_.running_models_[0];
+  const boost::shared_ptr<ActionDataAbstract> data = problem_.running_datas_[0];
+  shiftHorizon(model, data);
+}
+
+void SolverAbstract::shiftCandidate() {
+  const unsigned int& T = problem_.get_T();
+  // Swapping the vectors rotates the candidate without copying them
+  for (unsigned int t = 0; t < T; ++t) {
+    xs_[t].swap(xs_[t + 1]);
+  }
+  for (unsigned int t = 0; t + 1 < T; ++t) {
+    us_[t].swap(us_[t + 1]);
+  }
+
+  // Keeping the last control and rolling it out
+  if (T > 1) {
+    us_[T - 1] = us_[T - 2];
+  }
+  problem_.running_models_.back()->calc(problem_.running_datas_.back(), xs_[T - 1], us_[T - 1]);
+  xs_[T] = problem_.running_datas_.back()->get_xnext();
+}
+
 void SolverAbstract::setCallbacks(const std::vector<CallbackAbstract*>& callbacks) { callbacks_ = callbacks; }
 
+void SolverAbstract::flushCallbacks() {
+  const std::size_t& n_callbacks = callbacks_.size();
+  for (std::size_t c = 0; c < n_callbacks; ++c) {
+    callbacks_[c]->flush();
+  }
+}
+
 const ShootingProblem& SolverAbstract::get_problem() const { return problem_; }
 
 const std::vector<ActionModelAbstract*>& SolverAbstract::get_models() const { return models_; }
@@ -86,6 +155,8 @@ const std::vector<Eigen::VectorXd>& SolverAbstract::get_us() const { return us_;
 
 const bool& SolverAbstract::get_isFeasible() const { return is_feasible_; }
 
+const bool& SolverAbstract::get_isAccepted() const { return is_accepted_; }
+
 const unsigned int& SolverAbstract::get_iter() const { return iter_; }
 
 const double& SolverAbstract::get_cost() const { return cost_; }
@@ -104,6 +175,108 @@ const double& SolverAbstract::get_dV() const { return dV_; }
 
 const double& SolverAbstract::get_dVexp() const { return dVexp_; }
 
+const SolverTimings& SolverAbstract::get_timings() const { return timings_; }
+
+const SolverTimings& SolverAbstract::get_iterTimings() const { return iter_timings_; }
+
+const SolverStatus& SolverAbstract::get_status() const { return status_; }
+
+const int& SolverAbstract::get_failedNode() const { return failed_node_; }
+
+SolverAbstract::HistoryMap SolverAbstract::get_history() const {
+  return HistoryMap(history_->data(), static_cast<HistoryMatrix::Index>(history_size_), SolverHistoryNbFields);
+}
+
+std::size_t SolverAbstract::get_history_capacity() const { return static_cast<std::size_t>(history_->rows()); }
+
+boost::shared_ptr<const SolverAbstract::HistoryMatrix> SolverAbstract::get_history_storage() const {
+  return history_;
+}
+
+const double& SolverAbstract::get_time_budget() const { return time_budget_; }
+
+const bool& SolverAbstract::get_stoppedByBudget() const { return stopped_by_budget_; }
+
+void SolverAbstract::set_time_budget(const double& budget) { time_budget_ = budget; }
+
+void SolverAbstract::set_history_capacity(const std::size_t& capacity) {
+  // The previous storage is released once its views are destroyed
+  history_ = boost::make_shared<HistoryMatrix>(
+      HistoryMatrix::Zero(static_cast<HistoryMatrix::Index>(capacity), SolverHistoryNbFields));
+  history_size_ = 0;
+}
+
+void SolverAbstract::resetTimings() {
+  timings_.reset();
+  iter_timings_.reset();
+  budget_timer_.reset();
+  stopped_by_budget_ = false;
+}
+
+void SolverAbstract::resetIterTimings() { iter_timings_.reset(); }
+
+void SolverAbstract::addPhaseTime(const SolverPhase& phase, const double& duration) {
+  timings_.add(phase, duration);
+  iter_timings_.add(phase, duration);
+  double& prediction = phase_times_[phase];
+  prediction = std::max(duration, 0.9 * prediction + 0.1 * duration);
+}
+
+double SolverAbstract::predictPhaseTime(const SolverPhase& phase) const { return phase_times_[phase]; }
+
+bool SolverAbstract::stopByBudget(const double& duration) {
+  if (budget_timer_.get_duration() + duration > time_budget_) {
+    stopped_by_budget_ = true;
+  }
+  return stopped_by_budget_;
+}
+
+void SolverAbstract::resetHistory() { history_size_ = 0; }
+
+void SolverAbstract::recordIteration() {
+  if (history_size_ == static_cast<std::size_t>(history_->rows())) {
+    return;
+  }
+  HistoryMatrix::RowXpr row = history_->row(history_size_++);
+  row[SolverHistoryCost] = cost_;
+  row[SolverHistoryStop] = stop_;
+  row[SolverHistoryStepLength] = steplength_;
+  row[SolverHistoryXReg] = xreg_;
+  row[SolverHistoryUReg] = ureg_;
+  row[SolverHistoryDV] = dV_;
+  row[SolverHistoryDVexp] = dVexp_;
+  row[SolverHistoryFeasible] = is_feasible_ ? 1. : 0.;
+  row[SolverHistoryCalc] = iter_timings_.calc;
+  row[SolverHistoryCalcDiff] = iter_timings_.calcDiff;
+  row[SolverHistoryBackwardPass] = iter_timings_.backwardPass;
+  row[SolverHistoryForwardPass] = iter_timings_.forwardPass;
+}
+
+void SolverAbstract::addLineSearchTrial() {
+  ++timings_.ntrials;
+  ++iter_timings_.ntrials;
+}
+
+void SolverAbstract::addRegularizationRetry() {
+  ++timings_.nregularizations;
+  ++iter_timings_.nregularizations;
+}
+
+void SolverAbstract::addLinearizations() {
+  const unsigned int& nreused = problem_.get_nreused();
+  const unsigned int nlinearized = problem_.get_T() + 1 - nreused;
+  timings_.nlinearizations += nlinearized;
+  timings_.nreuses += nreused;
+  iter_timings_.nlinearizations += nlinearized;
+  iter_timings_.nreuses += nreused;
+}
+
+const SolverStatus& SolverAbstract::setStatus(const SolverStatus& status, const int& node) {
+  status_ = status;
+  failed_node_ = node;
+  return status_;
+}
+
 bool raiseIfNaN(const double& value) {
   if (std::isnan(value) || std::isinf(value) || value >= 1e30) {
     return true;
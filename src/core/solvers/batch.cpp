@@ -0,0 +1,159 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "crocoddyl/core/solvers/batch.hpp"
+#include "crocoddyl/core/utils/timer.hpp"
+#include <iostream>
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#include <omp.h>
+#endif
+
+namespace crocoddyl {
+
+SolverBatch::SolverBatch(ShootingProblem& problem, const unsigned int& nthreads)
+    : problem_(problem), nthreads_(1), duration_(0.) {
+  const unsigned int& T = problem_.get_T();
+  ix_.resize(T + 2);
+  iu_.resize(T + 1);
+  ix_[0] = 0;
+  iu_[0] = 0;
+  for (unsigned int t = 0; t < T; ++t) {
+    ActionModelAbstract* model = problem_.running_models_[t];
+    ix_[t + 1] = ix_[t] + model->get_state().get_nx();
+    iu_[t + 1] = iu_[t] + model->get_nu();
+  }
+  ix_[T + 1] = ix_[T] + problem_.terminal_model_->get_state().get_nx();
+  allocateWorkers();
+  set_nthreads(nthreads);
+}
+
+SolverBatch::~SolverBatch() {
+  for (std::size_t i = 0; i < solvers_.size(); ++i) {
+    delete solvers_[i];
+    delete problems_[i];
+  }
+}
+
+bool SolverBatch::solve(const std::vector<Eigen::VectorXd>& x0s, const Eigen::MatrixXd& init_xs,
+                        const Eigen::MatrixXd& init_us, const unsigned int& maxiter, const bool& is_feasible,
+                        const double& reginit) {
+  const unsigned int& T = problem_.get_T();
+  const int N = static_cast<int>(x0s.size());
+  assert((init_xs.size() == 0 || (init_xs.rows() == static_cast<long>(ix_.back()) && init_xs.cols() == N)) &&
+         "init_xs has wrong dimension");
+  assert((init_us.size() == 0 || (init_us.rows() == static_cast<long>(iu_.back()) && init_us.cols() == N)) &&
+         "init_us has wrong dimension");
+  xs_.resize(ix_.back(), N);
+  us_.resize(iu_.back(), N);
+  costs_.resize(N);
+  stops_.resize(N);
+  iters_.resize(N);
+  solved_.resize(N);
+
+  Timer timer;
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for num_threads(nthreads_) schedule(dynamic)
+#endif
+  for (int i = 0; i < N; ++i) {
+#ifdef CROCODDYL_WITH_MULTITHREADING
+    const int w = omp_get_thread_num();
+#else
+    const int w = 0;
+#endif
+    SolverFDDP& solver = *solvers_[w];
+    std::vector<Eigen::VectorXd>& xs = init_xs_[w];
+    std::vector<Eigen::VectorXd>& us = init_us_[w];
+    problems_[w]->set_x0(x0s[i]);
+    if (init_xs.size() != 0) {
+      for (unsigned int t = 0; t < T + 1; ++t) {
+        xs[t] = init_xs.col(i).segment(ix_[t], ix_[t + 1] - ix_[t]);
+      }
+    }
+    if (init_us.size() != 0) {
+      for (unsigned int t = 0; t < T; ++t) {
+        us[t] = init_us.col(i).segment(iu_[t], iu_[t + 1] - iu_[t]);
+      }
+    }
+    solved_[i] = solver.solve(init_xs.size() != 0 ? xs : DEFAULT_VECTOR, init_us.size() != 0 ? us : DEFAULT_VECTOR,
+                              maxiter, is_feasible, reginit);
+
+    for (unsigned int t = 0; t < T + 1; ++t) {
+      xs_.col(i).segment(ix_[t], ix_[t + 1] - ix_[t]) = solver.get_xs()[t];
+    }
+    for (unsigned int t = 0; t < T; ++t) {
+      us_.col(i).segment(iu_[t], iu_[t + 1] - iu_[t]) = solver.get_us()[t];
+    }
+    costs_[i] = solver.get_cost();
+    stops_[i] = solver.get_stop();
+    iters_[i] = solver.get_iter();
+  }
+  duration_ = timer.get_duration();
+
+  converged_.resize(N);
+  bool converged = true;
+  for (int i = 0; i < N; ++i) {
+    converged_[i] = solved_[i] != 0;
+    converged = converged && converged_[i];
+  }
+  return converged;
+}
+
+void SolverBatch::allocateWorkers() {
+  const unsigned int& T = problem_.get_T();
+  for (std::size_t i = solvers_.size(); i < nthreads_; ++i) {
+    // The problem of each thread shares the models, but it creates its own datas
+    ShootingProblem* problem =
+        new ShootingProblem(problem_.get_x0(), problem_.get_runningModels(), problem_.get_terminalModel());
+    problems_.push_back(problem);
+    solvers_.push_back(new SolverFDDP(*problem));
+    init_xs_.push_back(std::vector<Eigen::VectorXd>(T + 1));
+    init_us_.push_back(std::vector<Eigen::VectorXd>(T));
+    for (unsigned int t = 0; t < T + 1; ++t) {
+      init_xs_.back()[t] = Eigen::VectorXd::Zero(ix_[t + 1] - ix_[t]);
+    }
+    for (unsigned int t = 0; t < T; ++t) {
+      init_us_.back()[t] = Eigen::VectorXd::Zero(iu_[t + 1] - iu_[t]);
+    }
+  }
+}
+
+const std::vector<SolverFDDP*>& SolverBatch::get_solvers() const { return solvers_; }
+
+const unsigned int& SolverBatch::get_nthreads() const { return nthreads_; }
+
+const Eigen::MatrixXd& SolverBatch::get_xs() const { return xs_; }
+
+const Eigen::MatrixXd& SolverBatch::get_us() const { return us_; }
+
+const Eigen::VectorXd& SolverBatch::get_costs() const { return costs_; }
+
+const Eigen::VectorXd& SolverBatch::get_stops() const { return stops_; }
+
+const std::vector<unsigned int>& SolverBatch::get_iters() const { return iters_; }
+
+const std::vector<bool>& SolverBatch::get_converged() const { return converged_; }
+
+const double& SolverBatch::get_duration() const { return duration_; }
+
+double SolverBatch::get_throughput() const {
+  return duration_ > 0. ? 1e3 * static_cast<double>(costs_.size()) / duration_ : 0.;
+}
+
+void SolverBatch::set_nthreads(const unsigned int& nthreads) {
+  assert(nthreads > 0 && "The number of threads has to be positive");
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  nthreads_ = nthreads == 0 ? 1 : nthreads;
+  allocateWorkers();
+#else
+  if (nthreads != 1) {
+    std::cout << "Warning: crocoddyl was built without multithreading support, we cannot set nthreads" << std::endl;
+  }
+#endif  // CROCODDYL_WITH_MULTITHREADING
+}
+
+}  // namespace crocoddyl
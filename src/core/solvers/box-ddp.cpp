@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "crocoddyl/core/solvers/box-ddp.hpp"
+#include <iostream>
+#include <limits>
+
+namespace crocoddyl {
+
+SolverBoxDDP::SolverBoxDDP(ShootingProblem& problem)
+    : SolverDDP(problem), qp_(problem.running_models_[0]->get_nu()) {
+  const unsigned int& nu = problem_.running_models_[0]->get_nu();
+  ul_ = Eigen::VectorXd::Constant(nu, -std::numeric_limits<double>::infinity());
+  uu_ = Eigen::VectorXd::Constant(nu, std::numeric_limits<double>::infinity());
+  du_lb_ = Eigen::VectorXd::Zero(nu);
+  du_ub_ = Eigen::VectorXd::Zero(nu);
+  du_init_ = Eigen::VectorXd::Zero(nu);
+}
+
+SolverBoxDDP::~SolverBoxDDP() {}
+
+bool SolverBoxDDP::computeGains(const unsigned int& t) {
+  assert(problem_.running_models_[t]->get_nu() == qp_.get_nx() && "all the running models must have the same nu");
+
+  // The QP decision variable is the control step du = -k, which is bounded by the control limits
+  du_lb_ = ul_ - us_[t];
+  du_ub_ = uu_ - us_[t];
+
+  // Warm-starting the QP (and so its active set) with the step of the previous iteration. The feed-forward term is
+  // kept untouched, so a retry with a larger regularization is warm-started from the same step
+  du_init_ = -k_[t];
+  if (!qp_.solve(Quu_[t], Qu_[t], du_lb_, du_ub_, du_init_)) {
+    // The gains of a non-converged step (or clamped set) aren't a descent direction, so we increase the
+    // regularization instead
+    return false;
+  }
+  const Eigen::LLT<Eigen::MatrixXd>& Hff_llt = qp_.get_Hff_llt();
+  k_[t] = -qp_.get_x();
+
+  // The feedback gains of the clamped controls are zero
+  const std::vector<bool>& clamped = qp_.get_clamped();
+  K_[t] = Qxu_[t].transpose();
+  for (unsigned int i = 0; i < qp_.get_nx(); ++i) {
+    if (clamped[i]) {
+      K_[t].row(i).setZero();
+    }
+  }
+  Hff_llt.solveInPlace(K_[t]);
+
+  // The square-root recursion downdates the value function with the factor of Quu, as Qxu * K = K^T * Quu * K
+  if (sqrt_riccati_) {
+    Quu_factor_[t].triangularView<Eigen::Lower>() = Quu_[t];
+    Eigen::LLT<Eigen::Ref<Eigen::MatrixXd> > Quu_llt(Quu_factor_[t]);
+    return Quu_llt.info() == Eigen::Success;
+  }
+  return true;
+}
+
+double SolverBoxDDP::stoppingCriteria() {
+  stop_ = 0.;
+  const unsigned int& T = this->problem_.get_T();
+  for (unsigned int t = 0; t < T; ++t) {
+    const Eigen::VectorXd& u = us_[t];
+    const VectorMap& Qu = Qu_[t];
+    const long nu = Qu.size();
+    for (long i = 0; i < nu; ++i) {
+      // Projected gradient, i.e. we skip the controls that cannot decrease the cost due to their limits
+      if ((u[i] <= ul_[i] && Qu[i] > 0.) || (u[i] >= uu_[i] && Qu[i] < 0.)) {
+        continue;
+      }
+      stop_ += Qu[i] * Qu[i];
+    }
+  }
+  return stop_;
+}
+
+void SolverBoxDDP::clampControl(const unsigned int&, Eigen::VectorXd& u) const { u = u.cwiseMax(ul_).cwiseMin(uu_); }
+
+const Eigen::VectorXd& SolverBoxDDP::get_ul() const { return ul_; }
+
+const Eigen::VectorXd& SolverBoxDDP::get_uu() const { return uu_; }
+
+void SolverBoxDDP::set_ul(const Eigen::VectorXd& ul) {
+  assert(ul.size() == ul_.size() && "ul has wrong dimension");
+  ul_ = ul;
+}
+
+void SolverBoxDDP::set_uu(const Eigen::VectorXd& uu) {
+  assert(uu.size() == uu_.size() && "uu has wrong dimension");
+  uu_ = uu;
+}
+
+void SolverBoxDDP::set_nthreads_riccati(const unsigned int& nthreads) {
+  if (nthreads != 1) {
+    std::cout << "Warning: the backward pass of the box DDP cannot be partitioned, we cannot set nthreads_riccati"
+              << std::endl;
+  }
+}
+
+}  // namespace crocoddyl
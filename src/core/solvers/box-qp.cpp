@@ -0,0 +1,153 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "crocoddyl/core/solvers/box-qp.hpp"
+#include <cmath>
+
+namespace crocoddyl {
+
+BoxQP::BoxQP(const unsigned int& nx, const unsigned int& maxiter, const double& th_acceptstep,
+             const double& th_grad, const double& th_relimprove)
+    : nx_(nx),
+      maxiter_(maxiter),
+      th_acceptstep_(th_acceptstep),
+      th_grad_(th_grad),
+      th_relimprove_(th_relimprove),
+      x_(Eigen::VectorXd::Zero(nx)),
+      xnew_(Eigen::VectorXd::Zero(nx)),
+      g_(Eigen::VectorXd::Zero(nx)),
+      dx_(Eigen::VectorXd::Zero(nx)),
+      Hx_(Eigen::VectorXd::Zero(nx)),
+      Hff_(Eigen::MatrixXd::Identity(nx, nx)),
+      Hff_llt_(nx),
+      clamped_(nx, false),
+      clamped_prev_(nx, false),
+      nfree_(nx),
+      iter_(0) {
+  const unsigned int& n_alphas = 10;
+  alphas_.resize(n_alphas);
+  for (unsigned int n = 0; n < n_alphas; ++n) {
+    alphas_[n] = 1. / pow(2., static_cast<double>(n));
+  }
+  Hff_llt_.compute(Hff_);
+}
+
+BoxQP::~BoxQP() {}
+
+bool BoxQP::solve(const Eigen::Ref<const Eigen::MatrixXd>& H, const Eigen::Ref<const Eigen::VectorXd>& q,
+                  const Eigen::Ref<const Eigen::VectorXd>& lb, const Eigen::Ref<const Eigen::VectorXd>& ub,
+                  const Eigen::Ref<const Eigen::VectorXd>& xinit) {
+  assert(H.rows() == nx_ && H.cols() == nx_ && "H has wrong dimension");
+  assert(q.size() == nx_ && "q has wrong dimension");
+  assert(lb.size() == nx_ && "lb has wrong dimension");
+  assert(ub.size() == nx_ && "ub has wrong dimension");
+  assert(xinit.size() == nx_ && "xinit has wrong dimension");
+
+  // Projecting the initial guess onto the box, it defines the initial active set
+  x_ = xinit.cwiseMax(lb).cwiseMin(ub);
+  bool factorized = false;
+  double fprev = 0.;
+  for (iter_ = 0; iter_ < maxiter_; ++iter_) {
+    g_ = q;
+    g_.noalias() += H * x_;
+    const double f = 0.5 * x_.dot(g_ + q);
+
+    // Computing the clamped set, i.e. bounds that are reached with a gradient pointing outside the box
+    bool changed = !factorized;
+    nfree_ = 0;
+    for (unsigned int i = 0; i < nx_; ++i) {
+      clamped_[i] = (x_[i] <= lb[i] && g_[i] > 0.) || (x_[i] >= ub[i] && g_[i] < 0.);
+      if (!clamped_[i]) {
+        ++nfree_;
+      }
+      if (clamped_[i] != clamped_prev_[i]) {
+        changed = true;
+      }
+      clamped_prev_[i] = clamped_[i];
+    }
+
+    // Factorizing the free Hessian only when the active set has changed
+    if (changed) {
+      factorizeFreeHessian(H);
+      if (Hff_llt_.info() != Eigen::Success) {
+        return false;
+      }
+      factorized = true;
+    }
+
+    // Checking convergence over the free subspace
+    double gnorm = 0.;
+    for (unsigned int i = 0; i < nx_; ++i) {
+      if (clamped_[i]) {
+        g_[i] = 0.;
+      } else {
+        gnorm += g_[i] * g_[i];
+      }
+    }
+    if (nfree_ == 0 || std::sqrt(gnorm) < th_grad_) {
+      return true;
+    }
+    // Near the solution, the round-off errors stop the cost from decreasing before the gradient vanishes
+    if (iter_ > 0 && fprev - f < th_relimprove_ * std::abs(fprev)) {
+      return true;
+    }
+    fprev = f;
+
+    // Newton step over the free subspace, the clamped coordinates don't move
+    dx_ = -g_;
+    Hff_llt_.solveInPlace(dx_);
+
+    // Projected line search
+    const double sdotg = g_.dot(dx_);
+    bool accepted = false;
+    for (std::vector<double>::const_iterator it = alphas_.begin(); it != alphas_.end(); ++it) {
+      const double& alpha = *it;
+      xnew_ = x_ + alpha * dx_;
+      xnew_ = xnew_.cwiseMax(lb).cwiseMin(ub);
+      Hx_.noalias() = H * xnew_;
+      const double fnew = 0.5 * xnew_.dot(Hx_) + q.dot(xnew_);
+      if (fnew - f <= th_acceptstep_ * alpha * sdotg) {
+        x_ = xnew_;
+        accepted = true;
+        break;
+      }
+    }
+    // No step length decreases the cost, so the current iterate is the solution
+    if (!accepted) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void BoxQP::factorizeFreeHessian(const Eigen::Ref<const Eigen::MatrixXd>& H) {
+  for (unsigned int j = 0; j < nx_; ++j) {
+    for (unsigned int i = 0; i < nx_; ++i) {
+      if (clamped_[i] || clamped_[j]) {
+        Hff_(i, j) = i == j ? 1. : 0.;
+      } else {
+        Hff_(i, j) = H(i, j);
+      }
+    }
+  }
+  Hff_llt_.compute(Hff_);
+}
+
+const unsigned int& BoxQP::get_nx() const { return nx_; }
+
+const Eigen::VectorXd& BoxQP::get_x() const { return x_; }
+
+const std::vector<bool>& BoxQP::get_clamped() const { return clamped_; }
+
+const unsigned int& BoxQP::get_nfree() const { return nfree_; }
+
+const Eigen::LLT<Eigen::MatrixXd>& BoxQP::get_Hff_llt() const { return Hff_llt_; }
+
+const unsigned int& BoxQP::get_iter() const { return iter_; }
+
+}  // namespace crocoddyl
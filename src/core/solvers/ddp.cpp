@@ -7,18 +7,92 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "crocoddyl/core/solvers/ddp.hpp"
+#include "crocoddyl/core/utils/trace.hpp"
+#include <algorithm>
+#include <iostream>
+#include <new>
 
 namespace crocoddyl {
 
+namespace {
+
+/**
+ * @brief Round the size of a block up to a whole number of cache lines (of 64 bytes)
+ */
+std::size_t cacheAligned(const std::size_t& size) { return (size + 7) & ~static_cast<std::size_t>(7); }
+
+/**
+ * @brief Return the size of the Riccati workspace of a running node, whose next node has ndx_p state dimension
+ */
+std::size_t nodeSize(const std::size_t& ndx, const std::size_t& nu, const std::size_t& ndx_p) {
+  return 3 * cacheAligned(ndx * ndx) + cacheAligned(ndx * ndx_p) + cacheAligned(nu * std::max(ndx, ndx_p)) +
+         2 * cacheAligned(ndx * nu) + 2 * cacheAligned(nu * nu) + 2 * cacheAligned(ndx) + cacheAligned(ndx_p) +
+         3 * cacheAligned(nu);
+}
+
+/**
+ * @brief Point the map to the next block of the arena, which has room for size entries
+ */
+template <typename Map>
+void mapBlock(Map& map, double*& block, const std::size_t& rows, const std::size_t& cols, const std::size_t& size) {
+  new (&map) Map(block, rows, cols);
+  block += cacheAligned(size);
+}
+
+/**
+ * @brief Point the map to the next block of the arena
+ */
+template <typename Map>
+void mapBlock(Map& map, double*& block, const std::size_t& rows, const std::size_t& cols) {
+  mapBlock(map, block, rows, cols, rows * cols);
+}
+
+/**
+ * @brief Downdate the lower Cholesky factor L of a matrix A to the one of A - w * w^T, and return false if the
+ * result is not positive definite
+ *
+ * It runs the hyperbolic rotations in place, i.e. it overwrites L and w (a view of a vector).
+ */
+template <typename Matrix, typename Vector>
+bool choleskyDowndate(Matrix& L, Vector w) {
+  const long n = L.rows();
+  for (long k = 0; k < n; ++k) {
+    const double Lkk = L(k, k);
+    const double r2 = Lkk * Lkk - w(k) * w(k);
+    if (!(r2 > 0.)) {
+      return false;
+    }
+    const double r = std::sqrt(r2);
+    const double c = r / Lkk;
+    const double s = w(k) / Lkk;
+    L(k, k) = r;
+    const long m = n - k - 1;
+    if (m > 0) {
+      L.col(k).tail(m) = (L.col(k).tail(m) - s * w.tail(m)) / c;
+      w.tail(m) = c * w.tail(m) - s * L.col(k).tail(m);
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 SolverDDP::SolverDDP(ShootingProblem& problem)
     : SolverAbstract(problem),
       regfactor_(10.),
       regmin_(1e-9),
       regmax_(1e9),
       cost_try_(0.),
+      riccati_revision_(1),
       th_grad_(1e-12),
       th_step_(0.5),
-      was_feasible_(false) {
+      was_feasible_(false),
+      sqrt_riccati_(false),
+      cost_lb_(-std::numeric_limits<double>::infinity()),
+      is_calc_updated_(false),
+      nthreads_ls_(1),
+      ls_trial_(0),
+      nthreads_riccati_(1) {
   allocateData();
 
   const unsigned int& n_alphas = 10;
@@ -42,41 +116,58 @@ bool SolverDDP::solve(const std::vector<Eigen::VectorXd>& init_xs, const std::ve
     ureg_ = reginit;
   }
   was_feasible_ = false;
+  resetTimings();
+  resetHistory();
+  CallbackFlush flush(*this);
 
   bool recalc = true;
   for (iter_ = 0; iter_ < maxiter; ++iter_) {
+    // The first search direction is always computed, and so is the one of an accepted step (its duration was budgeted
+    // before accepting it). Thus, the gains are always the ones of the candidate
+    if (iter_ > 0 && !recalc && stopByBudget(predictIterationTime(recalc))) {
+      return false;
+    }
+    resetIterTimings();
+    is_accepted_ = false;
     while (true) {
-      try {
-        computeDirection(recalc);
-      } catch (const char* msg) {
-        recalc = false;
-        increaseRegularization();
-        if (xreg_ == regmax_) {
-          return false;
-        } else {
-          continue;
-        }
+      computeDirection(recalc);
+      if (status_ == SolverStatusSuccess) {
+        break;
+      }
+      recalc = false;
+      addRegularizationRetry();
+      increaseRegularization();
+      if (xreg_ == regmax_) {
+        return false;
       }
-      break;
     }
-    expectedImprovement();
+    updateExpectedImprovement();
 
     // We need to recalculate the derivatives when the step length passes
     recalc = false;
-    for (std::vector<double>::const_iterator it = alphas_.begin(); it != alphas_.end(); ++it) {
-      steplength_ = *it;
+    const unsigned int& n_alphas = static_cast<unsigned int>(alphas_.size());
+    for (unsigned int i = 0; i < n_alphas; ++i) {
+      steplength_ = alphas_[i];
+      // The trials of a batch of the parallel line search are rolled out at once
+      if (i % nthreads_ls_ == 0 && stopByBudget(predictPhaseTime(SolverPhaseForwardPass))) {
+        return false;
+      }
 
-      try {
-        dV_ = tryStep(steplength_);
-      } catch (const char* msg) {
+      dV_ = tryLineSearchStep(i);
+      if (status_ != SolverStatusSuccess) {
         continue;
       }
-      dVexp_ = steplength_ * (d_[0] + 0.5 * steplength_ * d_[1]);
 
-      if (d_[0] < th_grad_ || !is_feasible_ || dV_ > th_acceptstep_ * dVexp_) {
+      if (acceptStep()) {
+        // We keep the previous iterate if there is no time left for the search direction of the new one
+        if (stopByBudget(predictPhaseTime(SolverPhaseCalcDiff) + predictPhaseTime(SolverPhaseBackwardPass))) {
+          return false;
+        }
         was_feasible_ = is_feasible_;
-        setCandidate(xs_try_, us_try_, true);
+        setCandidate(xs_try_, us_try_, isTrialFeasible());
+        acceptTrialDatas();
         cost_ = cost_try_;
+        is_accepted_ = true;
         recalc = true;
         break;
       }
@@ -93,6 +184,7 @@ bool SolverDDP::solve(const std::vector<Eigen::VectorXd>& init_xs, const std::ve
     }
     stoppingCriteria();
 
+    recordIteration();
     const unsigned int& n_callbacks = static_cast<unsigned int>(callbacks_.size());
     for (unsigned int c = 0; c < n_callbacks; ++c) {
       CallbackAbstract& callback = *callbacks_[c];
@@ -110,6 +202,7 @@ void SolverDDP::computeDirection(const bool& recalc) {
   if (recalc) {
     calc();
   }
+  PhaseTimer timer(*this, SolverPhaseBackwardPass);
   backwardPass();
 }
 
@@ -118,6 +211,12 @@ double SolverDDP::tryStep(const double& steplength) {
   return cost_ - cost_try_;
 }
 
+void SolverDDP::setCandidate(const std::vector<Eigen::VectorXd>& xs_warm, const std::vector<Eigen::VectorXd>& us_warm,
+                             const bool& is_feasible) {
+  SolverAbstract::setCandidate(xs_warm, us_warm, is_feasible);
+  is_calc_updated_ = false;
+}
+
 double SolverDDP::stoppingCriteria() {
   stop_ = 0.;
   const unsigned int& T = this->problem_.get_T();
@@ -137,15 +236,34 @@ const Eigen::Vector2d& SolverDDP::expectedImprovement() {
   return d_;
 }
 
+void SolverDDP::updateExpectedImprovement() { expectedImprovement(); }
+
+bool SolverDDP::acceptStep() {
+  dVexp_ = steplength_ * (d_[0] + 0.5 * steplength_ * d_[1]);
+  return d_[0] < th_grad_ || !is_feasible_ || dV_ > th_acceptstep_ * dVexp_;
+}
+
+bool SolverDDP::isTrialFeasible() const { return true; }
+
 double SolverDDP::calc() {
-  cost_ = problem_.calcDiff(xs_, us_);
+  // The actions and their derivatives are evaluated separately in order to time them
+  if (!is_calc_updated_) {
+    PhaseTimer timer(*this, SolverPhaseCalc);
+    problem_.calc(xs_, us_);
+  }
+  {
+    PhaseTimer timer(*this, SolverPhaseCalcDiff);
+    cost_ = problem_.calcDiff(xs_, us_, false);
+  }
+  addLinearizations();
   if (!is_feasible_) {
     const Eigen::VectorXd& x0 = problem_.get_x0();
     problem_.running_models_[0]->get_state().diff(xs_[0], x0, gaps_[0]);
 
     const unsigned int& T = problem_.get_T();
     for (unsigned int t = 0; t < T; ++t) {
-      ActionModelAbstract* model = problem_.running_models_[t];
+      // The gap lives in the state of the next node
+      ActionModelAbstract* model = t + 1 < T ? problem_.running_models_[t + 1] : problem_.terminal_model_;
       boost::shared_ptr<ActionDataAbstract>& d = problem_.running_datas_[t];
       model->get_state().diff(xs_[t + 1], d->get_xnext(), gaps_[t + 1]);
     }
@@ -153,106 +271,459 @@ double SolverDDP::calc() {
   return cost_;
 }
 
-void SolverDDP::backwardPass() {
+SolverStatus SolverDDP::backwardPass() {
+  const unsigned int& T = problem_.get_T();
+  ++riccati_revision_;
   boost::shared_ptr<ActionDataAbstract>& d_T = problem_.terminal_data_;
   Vxx_.back() = d_T->get_Lxx();
   Vx_.back() = d_T->get_Lx();
 
-  x_reg_.fill(xreg_);
   if (!std::isnan(xreg_)) {
-    Vxx_.back().diagonal() += x_reg_;
+    Vxx_.back().diagonal().array() += xreg_;
+  }
+  if (sqrt_riccati_ && !factorizeValueHessian(T)) {
+    return setStatus(SolverStatusBackwardError, static_cast<int>(T));
   }
+  shiftValueGradient(T);
 
-  for (int t = static_cast<int>(problem_.get_T()) - 1; t >= 0; --t) {
-    ActionModelAbstract* m = problem_.running_models_[t];
-    boost::shared_ptr<ActionDataAbstract>& d = problem_.running_datas_[t];
-    const Eigen::MatrixXd& Vxx_p = Vxx_[t + 1];
-    const Eigen::VectorXd& Vx_p = Vx_[t + 1];
-    const Eigen::VectorXd& gap_p = gaps_[t + 1];
-
-    FxTVxx_p_.noalias() = d->get_Fx().transpose() * Vxx_p;
-    FuTVxx_p_[t].noalias() = d->get_Fu().transpose() * Vxx_p;
-    Qxx_[t].noalias() = d->get_Lxx() + FxTVxx_p_ * d->get_Fx();
-    Qxu_[t].noalias() = d->get_Lxu() + FxTVxx_p_ * d->get_Fu();
-    Quu_[t].noalias() = d->get_Luu() + FuTVxx_p_[t] * d->get_Fu();
-    if (!is_feasible_) {
-      // In case the xt+1 are not f(xt,ut) i.e warm start not obtained from roll-out.
-      fTVxx_p_.noalias() = Vxx_p * gap_p;
-      Qx_[t].noalias() = d->get_Lx() + d->get_Fx().transpose() * Vx_p + d->get_Fx().transpose() * fTVxx_p_;
-      Qu_[t].noalias() = d->get_Lu() + d->get_Fu().transpose() * Vx_p + d->get_Fu().transpose() * fTVxx_p_;
-    } else {
-      Qx_[t].noalias() = d->get_Lx() + d->get_Fx().transpose() * Vx_p;
-      Qu_[t].noalias() = d->get_Lu() + d->get_Fu().transpose() * Vx_p;
+  // Each segment but the last one needs at least two nodes, and the last segment is twice as long as the others
+  const unsigned int nseg = std::min(nthreads_riccati_, T / 2 > 0 ? T / 2 - 1 : 0);
+  if (nseg > 1 && !std::isnan(ureg_) && partitionedBackwardPass(nseg)) {
+    return status_;
+  }
+
+  for (int t = static_cast<int>(T) - 1; t >= 0; --t) {
+    if (!computeValueFunction(t)) {
+      return setStatus(SolverStatusBackwardError, t);
     }
+  }
+  return setStatus(SolverStatusSuccess);
+}
+
+bool SolverDDP::partitionedBackwardPass(const unsigned int& nseg) {
+  const unsigned int& T = problem_.get_T();
+  // The workspace of the segments has to fit the nodes, which may have changed after allocating it (e.g. by
+  // shifting the horizon)
+  if (seg_A_.size() < nseg) {
+    return false;
+  }
+  const long ndx = seg_A_[0].rows();
+  if (static_cast<long>(problem_.terminal_model_->get_state().get_ndx()) != ndx) {
+    return false;
+  }
+  for (unsigned int t = 0; t < T; ++t) {
+    ActionModelAbstract* model = problem_.running_models_[t];
+    if (static_cast<long>(model->get_state().get_ndx()) != ndx ||
+        static_cast<long>(model->get_nu()) > seg_G_[0].cols()) {
+      return false;
+    }
+  }
+  for (unsigned int s = 0; s < nseg; ++s) {
+    seg_first_[s] = s * T / (nseg + 1);
+  }
+  seg_first_[nseg] = T;
 
-    if (!std::isnan(ureg_)) {
-      unsigned int const& nu = m->get_nu();
-      Quu_[t].diagonal() += Eigen::VectorXd::Constant(nu, ureg_);
+  // The last segment runs the recursion from the terminal node, while the others are reduced to their maps
+  bool maps_ok = true;
+  const int n = static_cast<int>(nseg);
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for num_threads(nseg) schedule(static, 1) reduction(&& : maps_ok)
+#endif
+  for (int s = 0; s < n; ++s) {
+    seg_node_[s] = -1;
+    if (s + 1 < n) {
+      maps_ok = computeSegmentMap(s) && maps_ok;
+      continue;
+    }
+    for (int t = static_cast<int>(T) - 1; t >= static_cast<int>(seg_first_[s]); --t) {
+      if (!computeValueFunction(t)) {
+        seg_node_[s] = t;
+        break;
+      }
     }
+  }
+  if (seg_node_[nseg - 1] != -1) {
+    setStatus(SolverStatusBackwardError, seg_node_[nseg - 1]);
+    return true;
+  }
+  if (!maps_ok) {
+    return false;
+  }
 
-    computeGains(t);
+  // Serial sweep over the boundaries: given V(y) = 1/2 y^T S y + s^T y at the end of a segment, its value function
+  // at the start is P + A^T (I + S C)^-1 S A and p + A^T (I + S C)^-1 (s + S c)
+  const unsigned int& b_last = seg_first_[nseg - 1];
+  coupling_s_ = Qx_[b_last];
+  coupling_s_.noalias() -= K_[b_last].transpose() * Qu_[b_last];
+  for (int s = n - 2; s >= 0; --s) {
+    const unsigned int& a = seg_first_[s];
+    const MatrixMap& S = Vxx_[seg_first_[s + 1]];
+    coupling_M_.setIdentity();
+    coupling_M_.noalias() += S * seg_C_[s];
+    coupling_lu_.compute(coupling_M_);
 
-    if (std::isnan(ureg_)) {
-      Vx_[t].noalias() = Qx_[t] - K_[t].transpose() * Qu_[t];
-    } else {
-      Quuk_[t].noalias() = Quu_[t] * k_[t];
-      Vx_[t].noalias() = Qx_[t] + K_[t].transpose() * Quuk_[t] - 2 * K_[t].transpose() * Qu_[t];
+    coupling_SA_.noalias() = S * seg_A_[s];
+    coupling_M_ = coupling_lu_.solve(coupling_SA_);
+    Vxx_[a].noalias() += seg_A_[s].transpose() * coupling_M_;
+    Vxx_[a].triangularView<Eigen::StrictlyUpper>() = Vxx_[a].transpose();
+
+    coupling_v_ = coupling_s_;
+    coupling_v_.noalias() += S * seg_c_[s];
+    coupling_s_ = coupling_lu_.solve(coupling_v_);
+    Vx_[a] = seg_p_[s];
+    Vx_[a].noalias() += seg_A_[s].transpose() * coupling_s_;
+    coupling_s_ = Vx_[a];
+    shiftValueGradient(a);
+    if (raiseIfNaN(Vx_[a].lpNorm<Eigen::Infinity>()) || raiseIfNaN(Vxx_[a].lpNorm<Eigen::Infinity>()) ||
+        (sqrt_riccati_ && !factorizeValueHessian(a))) {
+      return false;
     }
-    Vxx_[t].noalias() = Qxx_[t] - Qxu_[t] * K_[t];
-    Vxx_[t] = 0.5 * (Vxx_[t] + Vxx_[t].transpose()).eval();  // TODO(cmastalli): as suggested by Nicolas
+  }
 
-    if (!std::isnan(xreg_)) {
-      Vxx_[t].diagonal() += x_reg_;
+  // The segments run the recursion from their boundaries. The first node of a segment writes the value function of
+  // its boundary, which is read by the previous segment, so these nodes are computed afterwards
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for num_threads(nseg) schedule(static, 1)
+#endif
+  for (int s = 0; s < n - 1; ++s) {
+    for (int t = static_cast<int>(seg_first_[s + 1]) - 1; t > static_cast<int>(seg_first_[s]); --t) {
+      if (!computeValueFunction(t)) {
+        seg_node_[s] = t;
+        break;
+      }
     }
+  }
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for num_threads(nseg) schedule(static, 1)
+#endif
+  for (int s = 0; s < n - 1; ++s) {
+    if (seg_node_[s] == -1 && !computeValueFunction(seg_first_[s])) {
+      seg_node_[s] = seg_first_[s];
+    }
+  }
 
-    if (raiseIfNaN(Vx_[t].lpNorm<Eigen::Infinity>())) {
-      throw "backward_error";
+  // As the serial recursion, we report the failure of the last node
+  const int node = *std::max_element(seg_node_.begin(), seg_node_.begin() + nseg);
+  setStatus(node == -1 ? SolverStatusSuccess : SolverStatusBackwardError, node);
+  return true;
+}
+
+bool SolverDDP::computeSegmentMap(const unsigned int& s) {
+  const int a = static_cast<int>(seg_first_[s]);
+  const int b = static_cast<int>(seg_first_[s + 1]);
+  Eigen::MatrixXd& A = seg_A_[s];
+  Eigen::MatrixXd& A_next = seg_A_next_[s];
+  Eigen::MatrixXd& C = seg_C_[s];
+  Eigen::VectorXd& c = seg_c_[s];
+  A.setIdentity();
+  C.setZero();
+  c.setZero();
+  for (int t = b - 1; t >= a; --t) {
+    boost::shared_ptr<ActionDataAbstract>& d = problem_.running_datas_[t];
+    const Eigen::MatrixXd& Fx = d->get_Fx();
+    const Eigen::MatrixXd& Fu = d->get_Fu();
+    const long nu = Fu.cols();
+    if (t + 1 == b) {
+      // The value function after the segment is zero, and the gap is part of the drift
+      Qxx_[t] = d->get_Lxx();
+      Qxu_[t] = d->get_Lxu();
+      Quu_[t] = d->get_Luu();
+      Qx_[t] = d->get_Lx();
+      Qu_[t] = d->get_Lu();
+    } else {
+      computeActionValueHessian(t);
+      computeActionValueGradient(t);
     }
-    if (raiseIfNaN(Vxx_[t].lpNorm<Eigen::Infinity>())) {
-      throw "backward_error";
+    Quu_[t].diagonal().array() += ureg_;
+    if (!computeGains(t)) {
+      return false;
     }
+    Quuk_[t].noalias() = Quu_[t] * k_[t];
+    Vx_[t].noalias() = Qx_[t] - K_[t].transpose() * Qu_[t];
+    if (!computeValueHessian(t)) {
+      return false;
+    }
+    if (t == a) {
+      seg_p_[s] = Vx_[t];
+    }
+    shiftValueGradient(t);
+
+    // Accumulating the closed-loop transition, drift and Gramian from the node t to the end of the segment
+    Eigen::Block<Eigen::MatrixXd, Eigen::Dynamic, Eigen::Dynamic, true> G = seg_G_[s].leftCols(nu);
+    G.noalias() = A * Fu;
+    if (!is_feasible_) {
+      c.noalias() += A * gaps_[t + 1];
+    }
+    c.noalias() -= G * k_[t];
+    A_next.noalias() = A * Fx;
+    A_next.noalias() -= G * K_[t];
+    A.swap(A_next);
+    Quu_factor_[t].triangularView<Eigen::Lower>().transpose().solveInPlace<Eigen::OnTheRight>(G);
+    C.selfadjointView<Eigen::Lower>().rankUpdate(G);
+  }
+  C.triangularView<Eigen::StrictlyUpper>() = C.transpose();
+  return !raiseIfNaN(A.lpNorm<Eigen::Infinity>()) && !raiseIfNaN(C.lpNorm<Eigen::Infinity>()) &&
+         !raiseIfNaN(c.lpNorm<Eigen::Infinity>()) && !raiseIfNaN(seg_p_[s].lpNorm<Eigen::Infinity>());
+}
+
+bool SolverDDP::computeValueFunction(const unsigned int& t) {
+  computeActionValueHessian(t);
+  computeActionValueGradient(t);
+  if (!std::isnan(ureg_)) {
+    Quu_[t].diagonal().array() += ureg_;
+  }
+
+  if (!computeGains(t)) {
+    return false;
+  }
+
+  Quuk_[t].noalias() = Quu_[t] * k_[t];
+  if (std::isnan(ureg_)) {
+    Vx_[t].noalias() = Qx_[t] - K_[t].transpose() * Qu_[t];
+  } else {
+    Vx_[t].noalias() = Qx_[t] + K_[t].transpose() * Quuk_[t] - 2 * K_[t].transpose() * Qu_[t];
+  }
+  if (!computeValueHessian(t)) {
+    return false;
+  }
+  shiftValueGradient(t);
+  return !raiseIfNaN(Vx_[t].lpNorm<Eigen::Infinity>()) && !raiseIfNaN(Vxx_[t].lpNorm<Eigen::Infinity>());
+}
+
+void SolverDDP::computeActionValueGradient(const unsigned int& t) {
+  boost::shared_ptr<ActionDataAbstract>& d = problem_.running_datas_[t];
+  const VectorMap& Vx_p = Vx_[t + 1];
+  if (!is_feasible_) {
+    // In case the xt+1 are not f(xt,ut) i.e warm start not obtained from roll-out. We need the gradient of the next
+    // value function at the rollout state
+    VectorMap& Vx_gap = Vx_gap_[t];
+    Vx_gap = Vx_p;
+    Vx_gap.noalias() += Vxx_[t + 1] * gaps_[t + 1];
+    Qx_[t].noalias() = d->get_Lx() + d->get_Fx().transpose() * Vx_gap;
+    Qu_[t].noalias() = d->get_Lu() + d->get_Fu().transpose() * Vx_gap;
+  } else {
+    Qx_[t].noalias() = d->get_Lx() + d->get_Fx().transpose() * Vx_p;
+    Qu_[t].noalias() = d->get_Lu() + d->get_Fu().transpose() * Vx_p;
   }
 }
 
-void SolverDDP::forwardPass(const double& steplength) {
+void SolverDDP::shiftValueGradient(const unsigned int&) {}
+
+SolverStatus SolverDDP::forwardPass(const double& steplength, const double& cost_max) {
+  // The rollout overwrites the problem's datas
+  is_calc_updated_ = false;
+  int node;
+  const SolverStatus status = forwardPassTrial(steplength, cost_max, problem_.running_datas_,
+                                               problem_.terminal_data_, xs_try_, us_try_, dx_, cost_try_, node);
+  return setStatus(status, node);
+}
+
+SolverStatus SolverDDP::forwardPassTrial(const double& steplength, const double& cost_max,
+                                         std::vector<boost::shared_ptr<ActionDataAbstract> >& running_datas,
+                                         boost::shared_ptr<ActionDataAbstract>& terminal_data,
+                                         std::vector<Eigen::VectorXd>& xs_try, std::vector<Eigen::VectorXd>& us_try,
+                                         std::vector<Eigen::VectorXd>& dx, double& cost_try, int& node) {
   assert(steplength <= 1. && "Step length has to be <= 1.");
   assert(steplength >= 0. && "Step length has to be >= 0.");
-  cost_try_ = 0.;
+  cost_try = 0.;
+  node = -1;
   const unsigned int& T = problem_.get_T();
+  xs_try[0] = problem_.get_x0();
   for (unsigned int t = 0; t < T; ++t) {
     ActionModelAbstract* m = problem_.running_models_[t];
-    boost::shared_ptr<ActionDataAbstract>& d = problem_.running_datas_[t];
+    boost::shared_ptr<ActionDataAbstract>& d = running_datas[t];
 
-    m->get_state().diff(xs_[t], xs_try_[t], dx_[t]);
-    us_try_[t] = us_[t] - k_[t] * steplength - K_[t] * dx_[t];
-    m->calc(d, xs_try_[t], us_try_[t]);
-    xs_try_[t + 1] = d->get_xnext();
-    cost_try_ += d->cost;
+    m->get_state().diff(xs_[t], xs_try[t], dx[t]);
+    us_try[t].noalias() = us_[t] - k_[t] * steplength - K_[t] * dx[t];
+    clampControl(t, us_try[t]);
+    {
+      CROCODDYL_TRACE_SCOPE("action", "calc", NULL, static_cast<int>(t));
+      m->calc(d, xs_try[t], us_try[t]);
+    }
+    xs_try[t + 1] = d->get_xnext();
+    cost_try += d->cost;
 
-    if (raiseIfNaN(cost_try_)) {
-      throw "forward_error";
+    if (raiseIfNaN(cost_try) || raiseIfNaN(xs_try[t + 1].lpNorm<Eigen::Infinity>())) {
+      node = static_cast<int>(t);
+      return SolverStatusForwardError;
     }
-    if (raiseIfNaN(xs_try_[t + 1].lpNorm<Eigen::Infinity>())) {
-      throw "forward_error";
+    // The remaining nodes, including the terminal one, cost at least cost_lb_
+    if (cost_try + static_cast<double>(T - t) * cost_lb_ > cost_max) {
+      node = static_cast<int>(t);
+      return SolverStatusStepRejected;
     }
   }
 
   ActionModelAbstract* m = problem_.terminal_model_;
-  boost::shared_ptr<ActionDataAbstract>& d = problem_.terminal_data_;
-  m->calc(d, xs_try_.back());
-  cost_try_ += d->cost;
+  boost::shared_ptr<ActionDataAbstract>& d = terminal_data;
+  CROCODDYL_TRACE_SCOPE("action", "calc", NULL, static_cast<int>(T));
+  m->calc(d, xs_try.back());
+  cost_try += d->cost;
 
-  if (raiseIfNaN(cost_try_)) {
-    throw "forward_error";
+  if (raiseIfNaN(cost_try)) {
+    node = static_cast<int>(T);
+    return SolverStatusForwardError;
   }
+  return SolverStatusSuccess;
 }
 
-void SolverDDP::computeGains(const unsigned int& t) {
-  Quu_llt_[t].compute(Quu_[t]);
+void SolverDDP::clampControl(const unsigned int&, Eigen::VectorXd&) const {}
+
+double SolverDDP::computeRejectionCost(const double& steplength) const {
+  // The step is always accepted if the candidate is infeasible or if the gradient vanishes
+  if (cost_lb_ == -std::numeric_limits<double>::infinity() || !is_feasible_ || d_[0] < th_grad_) {
+    return std::numeric_limits<double>::infinity();
+  }
+  // The step is rejected when dV <= th_acceptstep * dVexp, i.e. when cost_try >= cost - th_acceptstep * dVexp
+  return cost_ - th_acceptstep_ * steplength * (d_[0] + 0.5 * steplength * d_[1]);
+}
+
+double SolverDDP::tryLineSearchStep(const unsigned int& i) {
+  addLineSearchTrial();
+  if (nthreads_ls_ == 1) {
+    PhaseTimer timer(*this, SolverPhaseForwardPass);
+    forwardPass(alphas_[i], computeRejectionCost(alphas_[i]));
+    return cost_ - cost_try_;
+  }
+
+  // We roll out the next batch of step lengths once the previous one has been tried
+  const unsigned int k = i % nthreads_ls_;
+  if (k == 0) {
+    PhaseTimer timer(*this, SolverPhaseForwardPass);
+    forwardPassBatch(i);
+  }
+  if (ls_status_[k] != SolverStatusSuccess) {
+    setStatus(ls_status_[k], ls_node_[k]);
+    return cost_ - ls_cost_try_[k];
+  }
+
+  // Swapping the buffers avoids copying the trial, and the previous buffers are reused by the next batch
+  xs_try_.swap(ls_xs_try_[k]);
+  us_try_.swap(ls_us_try_[k]);
+  dx_.swap(ls_dx_[k]);
+  cost_try_ = ls_cost_try_[k];
+  ls_trial_ = k;
+  setStatus(SolverStatusSuccess);
+  return cost_ - cost_try_;
+}
+
+double SolverDDP::predictIterationTime(const bool& recalc) const {
+  double duration = predictPhaseTime(SolverPhaseBackwardPass) + predictPhaseTime(SolverPhaseForwardPass);
+  if (recalc) {
+    duration += predictPhaseTime(SolverPhaseCalcDiff);
+    if (!is_calc_updated_) {
+      duration += predictPhaseTime(SolverPhaseCalc);
+    }
+  }
+  return duration;
+}
+
+void SolverDDP::acceptTrialDatas() {
+  if (nthreads_ls_ > 1) {
+    // Double buffering: the datas of the accepted trial become the problem's datas, and the previous ones are reused
+    // by the next trials
+    const unsigned int& T = problem_.get_T();
+    std::vector<boost::shared_ptr<ActionDataAbstract> >& running_datas = ls_running_datas_[ls_trial_];
+    for (unsigned int t = 0; t < T; ++t) {
+      problem_.running_datas_[t].swap(running_datas[t]);
+      datas_[t] = problem_.running_datas_[t];
+    }
+    problem_.terminal_data_.swap(ls_terminal_datas_[ls_trial_]);
+    datas_.back() = problem_.terminal_data_;
+  }
+  is_calc_updated_ = true;
+}
+
+void SolverDDP::forwardPassBatch(const unsigned int& first) {
+  const int n = static_cast<int>(std::min(nthreads_ls_, static_cast<unsigned int>(alphas_.size()) - first));
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for num_threads(nthreads_ls_) schedule(static, 1)
+#endif
+  for (int k = 0; k < n; ++k) {
+    const double& alpha = alphas_[first + k];
+    ls_status_[k] = forwardPassTrial(alpha, computeRejectionCost(alpha), ls_running_datas_[k], ls_terminal_datas_[k],
+                                     ls_xs_try_[k], ls_us_try_[k], ls_dx_[k], ls_cost_try_[k], ls_node_[k]);
+  }
+}
+
+bool SolverDDP::computeGains(const unsigned int& t) {
+  // Factorizing a copy of Quu in place, inside the node's workspace. The factorization only reads the lower triangle
+  Quu_factor_[t].triangularView<Eigen::Lower>() = Quu_[t];
+  Eigen::LLT<Eigen::Ref<Eigen::MatrixXd> > Quu_llt(Quu_factor_[t]);
   K_[t] = Qxu_[t].transpose();
-  Quu_llt_[t].solveInPlace(K_[t]);
+  Quu_llt.solveInPlace(K_[t]);
   k_[t] = Qu_[t];
-  Quu_llt_[t].solveInPlace(k_[t]);
+  Quu_llt.solveInPlace(k_[t]);
+  return Quu_llt.info() == Eigen::Success;
+}
+
+void SolverDDP::computeActionValueHessian(const unsigned int& t) {
+  boost::shared_ptr<ActionDataAbstract>& d = problem_.running_datas_[t];
+  const Eigen::MatrixXd& Fx = d->get_Fx();
+  const Eigen::MatrixXd& Fu = d->get_Fu();
+
+  // Qxx, Quu and Vxx are symmetric, so we compute their lower triangles and copy them into the upper ones
+  Qxx_[t] = d->get_Lxx();
+  Quu_[t] = d->get_Luu();
+  MatrixMap& FxTVxx_p = FxTVxx_p_[t];
+  if (sqrt_riccati_) {
+    // With Vxx_p = L_p * L_p^T, the Hessian terms of the dynamics are rank updates by Fx^T * L_p and Fu^T * L_p
+    FxTVxx_p.noalias() = Fx.transpose() * Vxx_factor_[t + 1].triangularView<Eigen::Lower>();
+    FuTVxx_p_[t].noalias() = Fu.transpose() * Vxx_factor_[t + 1].triangularView<Eigen::Lower>();
+    Qxx_[t].selfadjointView<Eigen::Lower>().rankUpdate(FxTVxx_p);
+    Qxu_[t].noalias() = d->get_Lxu() + FxTVxx_p * FuTVxx_p_[t].transpose();
+    Quu_[t].selfadjointView<Eigen::Lower>().rankUpdate(FuTVxx_p_[t]);
+  } else {
+    const MatrixMap& Vxx_p = Vxx_[t + 1];
+    FxTVxx_p.noalias() = Fx.transpose() * Vxx_p;
+    FuTVxx_p_[t].noalias() = Fu.transpose() * Vxx_p;
+    Qxx_[t].triangularView<Eigen::Lower>() += FxTVxx_p * Fx;
+    Qxu_[t].noalias() = d->get_Lxu() + FxTVxx_p * Fu;
+    Quu_[t].triangularView<Eigen::Lower>() += FuTVxx_p_[t] * Fu;
+  }
+  Qxx_[t].triangularView<Eigen::StrictlyUpper>() = Qxx_[t].transpose();
+  Quu_[t].triangularView<Eigen::StrictlyUpper>() = Quu_[t].transpose();
+}
+
+bool SolverDDP::computeValueHessian(const unsigned int& t) {
+  if (sqrt_riccati_) {
+    // Vxx = Qxx - Qxu * K = Qxx - W^T * W with W = Lu^T * K and Quu = Lu * Lu^T, so its factor is the one of
+    // Qxx + xreg downdated by the rows of W. The scratch FuTVxx_p isn't needed anymore, so its block stores W
+    MatrixMap& L = Vxx_factor_[t];
+    L.triangularView<Eigen::Lower>() = Qxx_[t];
+    if (!std::isnan(xreg_)) {
+      L.diagonal().array() += xreg_;
+    }
+    Eigen::LLT<Eigen::Ref<Eigen::MatrixXd> > Qxx_llt(L);
+    if (Qxx_llt.info() != Eigen::Success) {
+      return false;
+    }
+    MatrixMap W(FuTVxx_p_[t].data(), K_[t].rows(), K_[t].cols());
+    W.noalias() = Quu_factor_[t].triangularView<Eigen::Lower>().transpose() * K_[t];
+    for (long i = 0; i < W.rows(); ++i) {
+      if (!choleskyDowndate(L, W.row(i).transpose())) {
+        return false;
+      }
+    }
+    // The value function used by the gradients and the expected improvement is rebuilt from its factor
+    L.triangularView<Eigen::StrictlyUpper>().setZero();
+    Vxx_[t].noalias() = L.triangularView<Eigen::Lower>() * L.transpose();
+    Vxx_[t].triangularView<Eigen::StrictlyUpper>() = Vxx_[t].transpose();
+    return true;
+  }
+  Vxx_[t] = Qxx_[t];
+  Vxx_[t].triangularView<Eigen::Lower>() -= Qxu_[t] * K_[t];
+  Vxx_[t].triangularView<Eigen::StrictlyUpper>() = Vxx_[t].transpose();
+  if (!std::isnan(xreg_)) {
+    Vxx_[t].diagonal().array() += xreg_;
+  }
+  return true;
+}
+
+bool SolverDDP::factorizeValueHessian(const unsigned int& t) {
+  Vxx_factor_[t].triangularView<Eigen::Lower>() = Vxx_[t];
+  Eigen::LLT<Eigen::Ref<Eigen::MatrixXd> > Vxx_llt(Vxx_factor_[t]);
+  return Vxx_llt.info() == Eigen::Success;
 }
 
 void SolverDDP::increaseRegularization() {
@@ -271,26 +742,136 @@ void SolverDDP::decreaseRegularization() {
   ureg_ = xreg_;
 }
 
+void SolverDDP::shiftCandidate() {
+  const unsigned int& T = problem_.get_T();
+  // Computing the control of the new last node before rotating the buffers. Note that us_try_ and dx_ are scratch
+  // buffers as they are overwritten by the rollouts
+  problem_.terminal_model_->get_state().diff(xs_[T - 1], xs_[T], dx_.back());
+  us_try_.back() = us_.back();
+  us_try_.back().noalias() -= K_.back() * dx_.back();
+
+  // Swapping the vectors rotates the candidate buffers without copying them. In the same way, the Riccati workspace
+  // is rotated by rotating the blocks of the running nodes in the arena
+  for (unsigned int t = 0; t < T; ++t) {
+    xs_[t].swap(xs_[t + 1]);
+  }
+  for (unsigned int t = 0; t + 1 < T; ++t) {
+    us_[t].swap(us_[t + 1]);
+  }
+  std::rotate(node_blocks_.begin(), node_blocks_.begin() + 1, node_blocks_.end());
+  for (unsigned int t = 0; t < T; ++t) {
+    mapNodeData(t);
+  }
+  ++riccati_revision_;
+  us_.back() = us_try_.back();
+  // The new last node has no step yet
+  k_.back().setZero();
+
+  // Rolling out the new last node
+  ActionModelAbstract* m = problem_.running_models_.back();
+  boost::shared_ptr<ActionDataAbstract>& d = problem_.running_datas_.back();
+  m->calc(d, xs_[T - 1], us_.back());
+  xs_.back() = d->get_xnext();
+  is_calc_updated_ = false;
+
+  // Rotating the datas of the line-search trials. They are created again only if the last node has a new model
+  const bool new_model = models_[0] != m;
+  for (std::size_t k = 0; k < ls_running_datas_.size(); ++k) {
+    std::vector<boost::shared_ptr<ActionDataAbstract> >& running_datas = ls_running_datas_[k];
+    std::rotate(running_datas.begin(), running_datas.begin() + 1, running_datas.end());
+    if (new_model) {
+      running_datas.back() = m->createData();
+    }
+  }
+}
+
 void SolverDDP::allocateData() {
   const unsigned int& T = problem_.get_T();
-  Vxx_.resize(T + 1);
-  Vx_.resize(T + 1);
-  Qxx_.resize(T);
-  Qxu_.resize(T);
-  Quu_.resize(T);
-  Qx_.resize(T);
-  Qu_.resize(T);
-  K_.resize(T);
-  k_.resize(T);
   gaps_.resize(T + 1);
 
   xs_try_.resize(T + 1);
   us_try_.resize(T);
-  dx_.resize(T);
+  dx_.resize(T + 1);
 
-  FuTVxx_p_.resize(T);
-  Quu_llt_.resize(T);
-  Quuk_.resize(T);
+  // The running nodes have blocks of the same size, so they can be rotated by shiftCandidate even if their models
+  // have different dimensions. As the next node of a running node changes with the rotation, the blocks fit the
+  // largest next state. The terminal node only stores its value function, after the running nodes
+  const std::size_t ndx_T = problem_.terminal_model_->get_state().get_ndx();
+  std::size_t ndx_max = ndx_T;
+  for (unsigned int t = 0; t < T; ++t) {
+    ndx_max = std::max(ndx_max, static_cast<std::size_t>(problem_.running_models_[t]->get_state().get_ndx()));
+  }
+  std::size_t node_size = 0;
+  for (unsigned int t = 0; t < T; ++t) {
+    ActionModelAbstract* model = problem_.running_models_[t];
+    node_size = std::max(node_size, nodeSize(model->get_state().get_ndx(), model->get_nu(), ndx_max));
+  }
+  const std::size_t arena_size = T * node_size + 2 * cacheAligned(ndx_T * ndx_T) + cacheAligned(ndx_T);
+  arena_ = Eigen::VectorXd::Zero(arena_size + 7);
+  double* block = arena_.data();
+  block += (64 - reinterpret_cast<std::size_t>(block) % 64) % 64 / sizeof(double);
+  node_blocks_.resize(T);
+  for (unsigned int t = 0; t < T; ++t) {
+    node_blocks_[t] = block;
+    block += node_size;
+  }
+
+  // Maps are not default constructible, so they are first created empty and then pointed to the arena
+  const MatrixMap no_matrix(NULL, 0, 0);
+  const VectorMap no_vector(NULL, 0);
+  Vxx_.clear();
+  Vxx_factor_.clear();
+  Vx_.clear();
+  Qxx_.clear();
+  Qxu_.clear();
+  Quu_.clear();
+  Qx_.clear();
+  Qu_.clear();
+  K_.clear();
+  k_.clear();
+  FxTVxx_p_.clear();
+  FuTVxx_p_.clear();
+  Vx_gap_.clear();
+  Quu_factor_.clear();
+  Quuk_.clear();
+  Vxx_.reserve(T + 1);
+  Vxx_factor_.reserve(T + 1);
+  Vx_.reserve(T + 1);
+  Qxx_.reserve(T);
+  Qxu_.reserve(T);
+  Quu_.reserve(T);
+  Qx_.reserve(T);
+  Qu_.reserve(T);
+  K_.reserve(T);
+  k_.reserve(T);
+  FxTVxx_p_.reserve(T);
+  FuTVxx_p_.reserve(T);
+  Vx_gap_.reserve(T);
+  Quu_factor_.reserve(T);
+  Quuk_.reserve(T);
+  for (unsigned int t = 0; t < T; ++t) {
+    Vxx_.push_back(no_matrix);
+    Vxx_factor_.push_back(no_matrix);
+    Vx_.push_back(no_vector);
+    Qxx_.push_back(no_matrix);
+    Qxu_.push_back(no_matrix);
+    Quu_.push_back(no_matrix);
+    Qx_.push_back(no_vector);
+    Qu_.push_back(no_vector);
+    K_.push_back(no_matrix);
+    k_.push_back(no_vector);
+    FxTVxx_p_.push_back(no_matrix);
+    FuTVxx_p_.push_back(no_matrix);
+    Vx_gap_.push_back(no_vector);
+    Quu_factor_.push_back(no_matrix);
+    Quuk_.push_back(no_vector);
+    mapNodeData(t);
+  }
+  Vxx_.push_back(MatrixMap(block, ndx_T, ndx_T));
+  block += cacheAligned(ndx_T * ndx_T);
+  Vxx_factor_.push_back(MatrixMap(block, ndx_T, ndx_T));
+  block += cacheAligned(ndx_T * ndx_T);
+  Vx_.push_back(VectorMap(block, ndx_T));
 
   for (unsigned int t = 0; t < T; ++t) {
     ActionModelAbstract* model = problem_.running_models_[t];
@@ -298,15 +879,6 @@ void SolverDDP::allocateData() {
     const unsigned int& ndx = model->get_state().get_ndx();
     const unsigned int& nu = model->get_nu();
 
-    Vxx_[t] = Eigen::MatrixXd::Zero(ndx, ndx);
-    Vx_[t] = Eigen::VectorXd::Zero(ndx);
-    Qxx_[t] = Eigen::MatrixXd::Zero(ndx, ndx);
-    Qxu_[t] = Eigen::MatrixXd::Zero(ndx, nu);
-    Quu_[t] = Eigen::MatrixXd::Zero(nu, nu);
-    Qx_[t] = Eigen::VectorXd::Zero(ndx);
-    Qu_[t] = Eigen::VectorXd::Zero(nu);
-    K_[t] = Eigen::MatrixXd::Zero(nu, ndx);
-    k_[t] = Eigen::VectorXd::Zero(nu);
     gaps_[t] = Eigen::VectorXd::Zero(ndx);
 
     if (t == 0) {
@@ -316,40 +888,193 @@ void SolverDDP::allocateData() {
     }
     us_try_[t] = Eigen::VectorXd::Constant(nu, NAN);
     dx_[t] = Eigen::VectorXd::Zero(ndx);
-
-    FuTVxx_p_[t] = Eigen::MatrixXd::Zero(nu, ndx);
-    Quu_llt_[t] = Eigen::LLT<Eigen::MatrixXd>(nu);
-    Quuk_[t] = Eigen::VectorXd(nu);
   }
   const unsigned int& ndx = problem_.terminal_model_->get_state().get_ndx();
-  Vxx_.back() = Eigen::MatrixXd::Zero(ndx, ndx);
-  Vx_.back() = Eigen::VectorXd::Zero(ndx);
   xs_try_.back() = problem_.terminal_model_->get_state().zero();
+  dx_.back() = Eigen::VectorXd::Zero(ndx);
   gaps_.back() = Eigen::VectorXd::Zero(ndx);
 
-  x_reg_ = Eigen::VectorXd::Constant(ndx, xreg_);
-  FxTVxx_p_ = Eigen::MatrixXd::Zero(ndx, ndx);
-  fTVxx_p_ = Eigen::VectorXd::Zero(ndx);
+  xnext_ = problem_.get_x0();
+
+  fTVxx_p_ = Eigen::VectorXd::Zero(ndx_max);
+}
+
+void SolverDDP::mapNodeData(const unsigned int& t) {
+  // The blocks are sorted as they are written by the backward pass, but the scratch of the products with the next
+  // value function is last. Its size depends on the next node, so the rotation of the nodes keeps the other blocks
+  // in place
+  const unsigned int& T = problem_.get_T();
+  ActionModelAbstract* model = problem_.running_models_[t];
+  ActionModelAbstract* model_p = t + 1 < T ? problem_.running_models_[t + 1] : problem_.terminal_model_;
+  const std::size_t ndx = model->get_state().get_ndx();
+  const std::size_t ndx_p = model_p->get_state().get_ndx();
+  const std::size_t nu = model->get_nu();
+  double* block = node_blocks_[t];
+  mapBlock(Qxx_[t], block, ndx, ndx);
+  mapBlock(Qxu_[t], block, ndx, nu);
+  mapBlock(Quu_[t], block, nu, nu);
+  mapBlock(Qx_[t], block, ndx, 1);
+  mapBlock(Qu_[t], block, nu, 1);
+  mapBlock(Quu_factor_[t], block, nu, nu);
+  mapBlock(K_[t], block, nu, ndx);
+  mapBlock(k_[t], block, nu, 1);
+  mapBlock(Quuk_[t], block, nu, 1);
+  mapBlock(Vx_[t], block, ndx, 1);
+  mapBlock(Vxx_[t], block, ndx, ndx);
+  mapBlock(Vxx_factor_[t], block, ndx, ndx);
+  mapBlock(FxTVxx_p_[t], block, ndx, ndx_p);
+  mapBlock(FuTVxx_p_[t], block, nu, ndx_p, nu * std::max(ndx, ndx_p));
+  mapBlock(Vx_gap_[t], block, ndx_p, 1);
+  assert(static_cast<std::size_t>(block - node_blocks_[t]) == nodeSize(ndx, nu, ndx_p) &&
+         "wrong size of the node block");
 }
 
-const std::vector<Eigen::MatrixXd>& SolverDDP::get_Vxx() const { return Vxx_; }
+void SolverDDP::allocateLineSearchData() {
+  // Each trial has its own copy of the datas, as the action models are evaluated concurrently
+  const unsigned int& T = problem_.get_T();
+  const unsigned int n_trials = nthreads_ls_ == 1 ? 0 : nthreads_ls_;
+  ls_running_datas_.resize(n_trials);
+  ls_terminal_datas_.resize(n_trials);
+  ls_xs_try_.assign(n_trials, xs_try_);
+  ls_us_try_.assign(n_trials, us_try_);
+  ls_dx_.assign(n_trials, dx_);
+  ls_cost_try_.assign(n_trials, 0.);
+  ls_status_.assign(n_trials, SolverStatusSuccess);
+  ls_node_.assign(n_trials, -1);
+  for (unsigned int k = 0; k < n_trials; ++k) {
+    ls_running_datas_[k].resize(T);
+    for (unsigned int t = 0; t < T; ++t) {
+      ls_running_datas_[k][t] = problem_.running_models_[t]->createData();
+    }
+    ls_terminal_datas_[k] = problem_.terminal_model_->createData();
+  }
+}
 
-const std::vector<Eigen::VectorXd>& SolverDDP::get_Vx() const { return Vx_; }
+bool SolverDDP::allocateRiccatiData() {
+  // The segments share the state dimension, as the maps between their boundaries are square
+  const unsigned int& T = problem_.get_T();
+  const unsigned int& ndx = problem_.terminal_model_->get_state().get_ndx();
+  unsigned int nu = 0;
+  bool same_ndx = true;
+  for (unsigned int t = 0; t < T; ++t) {
+    same_ndx = same_ndx && problem_.running_models_[t]->get_state().get_ndx() == ndx;
+    nu = std::max(nu, problem_.running_models_[t]->get_nu());
+  }
+  const unsigned int n_segments = nthreads_riccati_ > 1 && same_ndx ? nthreads_riccati_ : 0;
+  seg_first_.assign(n_segments + 1, 0);
+  seg_A_.assign(n_segments, Eigen::MatrixXd::Zero(ndx, ndx));
+  seg_A_next_.assign(n_segments, Eigen::MatrixXd::Zero(ndx, ndx));
+  seg_C_.assign(n_segments, Eigen::MatrixXd::Zero(ndx, ndx));
+  seg_c_.assign(n_segments, Eigen::VectorXd::Zero(ndx));
+  seg_p_.assign(n_segments, Eigen::VectorXd::Zero(ndx));
+  seg_G_.assign(n_segments, Eigen::MatrixXd::Zero(ndx, nu));
+  seg_node_.assign(n_segments, -1);
+  if (n_segments == 0) {
+    coupling_lu_ = Eigen::PartialPivLU<Eigen::MatrixXd>();
+    coupling_M_.resize(0, 0);
+    coupling_SA_.resize(0, 0);
+    coupling_v_.resize(0);
+    coupling_s_.resize(0);
+    return same_ndx;
+  }
+  coupling_lu_ = Eigen::PartialPivLU<Eigen::MatrixXd>(ndx);
+  coupling_M_ = Eigen::MatrixXd::Zero(ndx, ndx);
+  coupling_SA_ = Eigen::MatrixXd::Zero(ndx, ndx);
+  coupling_v_ = Eigen::VectorXd::Zero(ndx);
+  coupling_s_ = Eigen::VectorXd::Zero(ndx);
+  return true;
+}
 
-const std::vector<Eigen::MatrixXd>& SolverDDP::get_Qxx() const { return Qxx_; }
+template <typename Map, typename Dense>
+const std::vector<Dense>& SolverDDP::copyNodes(const std::vector<Map>& maps, NodeCopies<Dense>& copies) const {
+  if (copies.revision != riccati_revision_) {
+    copies.nodes.resize(maps.size());
+    for (std::size_t i = 0; i < maps.size(); ++i) {
+      copies.nodes[i] = maps[i];
+    }
+    copies.revision = riccati_revision_;
+  }
+  return copies.nodes;
+}
 
-const std::vector<Eigen::MatrixXd>& SolverDDP::get_Qxu() const { return Qxu_; }
+const std::vector<Eigen::MatrixXd>& SolverDDP::get_Vxx() const { return copyNodes(Vxx_, Vxx_copy_); }
 
-const std::vector<Eigen::MatrixXd>& SolverDDP::get_Quu() const { return Quu_; }
+const std::vector<Eigen::VectorXd>& SolverDDP::get_Vx() const { return copyNodes(Vx_, Vx_copy_); }
 
-const std::vector<Eigen::VectorXd>& SolverDDP::get_Qx() const { return Qx_; }
+const std::vector<Eigen::MatrixXd>& SolverDDP::get_Qxx() const { return copyNodes(Qxx_, Qxx_copy_); }
 
-const std::vector<Eigen::VectorXd>& SolverDDP::get_Qu() const { return Qu_; }
+const std::vector<Eigen::MatrixXd>& SolverDDP::get_Qxu() const { return copyNodes(Qxu_, Qxu_copy_); }
 
-const std::vector<Eigen::MatrixXd>& SolverDDP::get_K() const { return K_; }
+const std::vector<Eigen::MatrixXd>& SolverDDP::get_Quu() const { return copyNodes(Quu_, Quu_copy_); }
 
-const std::vector<Eigen::VectorXd>& SolverDDP::get_k() const { return k_; }
+const std::vector<Eigen::VectorXd>& SolverDDP::get_Qx() const { return copyNodes(Qx_, Qx_copy_); }
+
+const std::vector<Eigen::VectorXd>& SolverDDP::get_Qu() const { return copyNodes(Qu_, Qu_copy_); }
+
+const std::vector<Eigen::MatrixXd>& SolverDDP::get_K() const { return copyNodes(K_, K_copy_); }
+
+const std::vector<Eigen::VectorXd>& SolverDDP::get_k() const { return copyNodes(k_, k_copy_); }
+
+const std::vector<SolverDDP::MatrixMap>& SolverDDP::get_Vxx_map() const { return Vxx_; }
+
+const std::vector<SolverDDP::VectorMap>& SolverDDP::get_Vx_map() const { return Vx_; }
+
+const std::vector<SolverDDP::MatrixMap>& SolverDDP::get_Qxx_map() const { return Qxx_; }
+
+const std::vector<SolverDDP::MatrixMap>& SolverDDP::get_Qxu_map() const { return Qxu_; }
+
+const std::vector<SolverDDP::MatrixMap>& SolverDDP::get_Quu_map() const { return Quu_; }
+
+const std::vector<SolverDDP::VectorMap>& SolverDDP::get_Qx_map() const { return Qx_; }
+
+const std::vector<SolverDDP::VectorMap>& SolverDDP::get_Qu_map() const { return Qu_; }
+
+const std::vector<SolverDDP::MatrixMap>& SolverDDP::get_K_map() const { return K_; }
+
+const std::vector<SolverDDP::VectorMap>& SolverDDP::get_k_map() const { return k_; }
 
 const std::vector<Eigen::VectorXd>& SolverDDP::get_gaps() const { return gaps_; }
 
+const unsigned int& SolverDDP::get_nthreads_linesearch() const { return nthreads_ls_; }
+
+const unsigned int& SolverDDP::get_nthreads_riccati() const { return nthreads_riccati_; }
+
+const bool& SolverDDP::get_sqrt_riccati() const { return sqrt_riccati_; }
+
+const double& SolverDDP::get_cost_lower_bound() const { return cost_lb_; }
+
+void SolverDDP::set_nthreads_linesearch(const unsigned int& nthreads) {
+  assert(nthreads > 0 && "The number of threads has to be positive");
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  // There is no need of more threads than step lengths
+  nthreads_ls_ = std::min(std::max(nthreads, 1u), static_cast<unsigned int>(alphas_.size()));
+  allocateLineSearchData();
+#else
+  if (nthreads != 1) {
+    std::cout << "Warning: crocoddyl was built without multithreading support, we cannot set nthreads_linesearch"
+              << std::endl;
+  }
+#endif  // CROCODDYL_WITH_MULTITHREADING
+}
+
+void SolverDDP::set_nthreads_riccati(const unsigned int& nthreads) {
+  assert(nthreads > 0 && "The number of threads has to be positive");
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  nthreads_riccati_ = std::max(nthreads, 1u);
+  if (!allocateRiccatiData()) {
+    std::cout << "Warning: the nodes have different state dimensions, so the backward pass isn't partitioned"
+              << std::endl;
+  }
+#else
+  if (nthreads != 1) {
+    std::cout << "Warning: crocoddyl was built without multithreading support, we cannot set nthreads_riccati"
+              << std::endl;
+  }
+#endif  // CROCODDYL_WITH_MULTITHREADING
+}
+
+void SolverDDP::set_sqrt_riccati(const bool& sqrt_riccati) { sqrt_riccati_ = sqrt_riccati; }
+
+void SolverDDP::set_cost_lower_bound(const double& cost_lb) { cost_lb_ = cost_lb; }
+
 }  // namespace crocoddyl
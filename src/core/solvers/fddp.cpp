@@ -0,0 +1,279 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "crocoddyl/core/solvers/fddp.hpp"
+#include "crocoddyl/core/utils/trace.hpp"
+#include <algorithm>
+
+namespace crocoddyl {
+
+SolverFDDP::SolverFDDP(ShootingProblem& problem)
+    : SolverDDP(problem),
+      dg_(0.),
+      dq_(0.),
+      dv_(0.),
+      th_acceptnegstep_(2.),
+      multiple_shooting_(false),
+      th_gaptol_(1e-9) {}
+
+SolverFDDP::~SolverFDDP() {}
+
+bool SolverFDDP::acceptStep() {
+  // The expected improvement depends on the rollout (xs_try) because of the gaps
+  expectedImprovement();
+  dVexp_ = steplength_ * (d_[0] + 0.5 * steplength_ * d_[1]);
+  if (dVexp_ >= 0) {  // descend direction
+    return d_[0] < th_grad_ || dV_ > th_acceptstep_ * dVexp_;
+  }
+  // reducing the gaps by allowing a small increment in the cost value
+  return dV_ > th_acceptnegstep_ * dVexp_;
+}
+
+bool SolverFDDP::isTrialFeasible() const {
+  // The gaps are only closed by a full step, and a multiple-shooting trial keeps the defects of the linearization
+  return !multiple_shooting_ && (was_feasible_ || steplength_ == 1);
+}
+
+const Eigen::Vector2d& SolverFDDP::expectedImprovement() {
+  dv_ = 0.;
+  if (!is_feasible_) {
+    const unsigned int& T = problem_.get_T();
+    for (unsigned int t = 0; t < T; ++t) {
+      problem_.running_models_[t]->get_state().diff(xs_try_[t], xs_[t], dx_[t]);
+      const long ndx = dx_[t].size();
+      fTVxx_p_.head(ndx).noalias() = Vxx_[t] * dx_[t];
+      dv_ -= gaps_[t].dot(fTVxx_p_.head(ndx));
+    }
+    problem_.terminal_model_->get_state().diff(xs_try_.back(), xs_.back(), dx_.back());
+    const long ndx = dx_.back().size();
+    fTVxx_p_.head(ndx).noalias() = Vxx_.back() * dx_.back();
+    dv_ -= gaps_.back().dot(fTVxx_p_.head(ndx));
+  }
+  d_[0] = dg_ + dv_;
+  d_[1] = dq_ - 2 * dv_;
+  return d_;
+}
+
+void SolverFDDP::updateExpectedImprovement() {
+  dg_ = 0.;
+  dq_ = 0.;
+  if (!is_feasible_) {
+    dg_ -= Vx_.back().dot(gaps_.back());
+    const long ndx = gaps_.back().size();
+    fTVxx_p_.head(ndx).noalias() = Vxx_.back() * gaps_.back();
+    dq_ += gaps_.back().dot(fTVxx_p_.head(ndx));
+  }
+  const unsigned int& T = problem_.get_T();
+  for (unsigned int t = 0; t < T; ++t) {
+    dg_ += Qu_[t].dot(k_[t]);
+    dq_ -= k_[t].dot(Quuk_[t]);
+    if (!is_feasible_) {
+      dg_ -= Vx_[t].dot(gaps_[t]);
+      const long ndx = gaps_[t].size();
+      fTVxx_p_.head(ndx).noalias() = Vxx_[t] * gaps_[t];
+      dq_ += gaps_[t].dot(fTVxx_p_.head(ndx));
+    }
+  }
+}
+
+double SolverFDDP::calc() {
+  SolverDDP::calc();
+  const unsigned int& T = problem_.get_T();
+  if (multiple_shooting_ && !is_feasible_) {
+    // The defects of a multiple-shooting trial don't vanish with a full step, but with the linearization error
+    double gap = 0.;
+    for (unsigned int t = 0; t < T + 1; ++t) {
+      gap = std::max(gap, gaps_[t].lpNorm<Eigen::Infinity>());
+    }
+    if (gap <= th_gaptol_) {
+      is_feasible_ = true;
+      for (unsigned int t = 0; t < T + 1; ++t) {
+        gaps_[t].setZero();
+      }
+    }
+  } else if (is_feasible_ && !was_feasible_) {
+    // The gaps have been closed by a full step, so we reset them
+    for (unsigned int t = 0; t < T + 1; ++t) {
+      gaps_[t].setZero();
+    }
+  }
+  return cost_;
+}
+
+void SolverFDDP::computeActionValueGradient(const unsigned int& t) {
+  boost::shared_ptr<ActionDataAbstract>& d = problem_.running_datas_[t];
+  const VectorMap& Vx_p = Vx_[t + 1];
+  Qx_[t].noalias() = d->get_Lx() + d->get_Fx().transpose() * Vx_p;
+  Qu_[t].noalias() = d->get_Lu() + d->get_Fu().transpose() * Vx_p;
+}
+
+void SolverFDDP::shiftValueGradient(const unsigned int& t) {
+  // Compute and store the Vx gradient at the end of the interval (rollout state)
+  if (!is_feasible_) {
+    Vx_[t].noalias() += Vxx_[t] * gaps_[t];
+  }
+}
+
+SolverStatus SolverFDDP::forwardPassTrial(const double& steplength, const double& cost_max,
+                                          std::vector<boost::shared_ptr<ActionDataAbstract> >& running_datas,
+                                          boost::shared_ptr<ActionDataAbstract>& terminal_data,
+                                          std::vector<Eigen::VectorXd>& xs_try, std::vector<Eigen::VectorXd>& us_try,
+                                          std::vector<Eigen::VectorXd>& dx, double& cost_try, int& node) {
+  assert(steplength <= 1. && "Step length has to be <= 1.");
+  assert(steplength >= 0. && "Step length has to be >= 0.");
+  if (multiple_shooting_) {
+    return forwardPassMultipleShooting(steplength, running_datas, terminal_data, xs_try, us_try, dx, cost_try, node);
+  }
+  cost_try = 0.;
+  node = -1;
+  const unsigned int& T = problem_.get_T();
+  for (unsigned int t = 0; t < T; ++t) {
+    ActionModelAbstract* m = problem_.running_models_[t];
+    boost::shared_ptr<ActionDataAbstract>& d = running_datas[t];
+    const Eigen::VectorXd& xnext = t == 0 ? problem_.get_x0() : running_datas[t - 1]->get_xnext();
+
+    // The gaps are closed progressively, i.e. only a full step makes the rollout feasible
+    if (is_feasible_ || steplength == 1) {
+      xs_try[t] = xnext;
+    } else {
+      dx[t] = gaps_[t] * (steplength - 1);
+      m->get_state().integrate(xnext, dx[t], xs_try[t]);
+    }
+    m->get_state().diff(xs_[t], xs_try[t], dx[t]);
+    us_try[t].noalias() = us_[t] - k_[t] * steplength - K_[t] * dx[t];
+    {
+      CROCODDYL_TRACE_SCOPE("action", "calc", NULL, static_cast<int>(t));
+      m->calc(d, xs_try[t], us_try[t]);
+    }
+    cost_try += d->cost;
+
+    if (raiseIfNaN(cost_try) || raiseIfNaN(d->get_xnext().lpNorm<Eigen::Infinity>())) {
+      node = static_cast<int>(t);
+      return SolverStatusForwardError;
+    }
+    if (cost_try + static_cast<double>(T - t) * cost_lb_ > cost_max) {
+      node = static_cast<int>(t);
+      return SolverStatusStepRejected;
+    }
+  }
+
+  ActionModelAbstract* m = problem_.terminal_model_;
+  boost::shared_ptr<ActionDataAbstract>& d = terminal_data;
+  const Eigen::VectorXd& xnext = T == 0 ? problem_.get_x0() : running_datas.back()->get_xnext();
+  if (is_feasible_ || steplength == 1) {
+    xs_try.back() = xnext;
+  } else {
+    dx.back() = gaps_.back() * (steplength - 1);
+    m->get_state().integrate(xnext, dx.back(), xs_try.back());
+  }
+  CROCODDYL_TRACE_SCOPE("action", "calc", NULL, static_cast<int>(T));
+  m->calc(d, xs_try.back());
+  cost_try += d->cost;
+
+  if (raiseIfNaN(cost_try)) {
+    node = static_cast<int>(T);
+    return SolverStatusForwardError;
+  }
+  return SolverStatusSuccess;
+}
+
+SolverStatus SolverFDDP::forwardPassMultipleShooting(
+    const double& steplength, std::vector<boost::shared_ptr<ActionDataAbstract> >& running_datas,
+    boost::shared_ptr<ActionDataAbstract>& terminal_data, std::vector<Eigen::VectorXd>& xs_try,
+    std::vector<Eigen::VectorXd>& us_try, std::vector<Eigen::VectorXd>& dx, double& cost_try, int& node) {
+  // The prediction reads the derivatives of the candidate from the problem's datas, as the trial's datas could be
+  // the ones of the parallel line search. It is done before the evaluation of the trial, which overwrites them
+  const unsigned int& T = problem_.get_T();
+  if (is_feasible_) {
+    dx[0].setZero();
+  } else {
+    dx[0] = gaps_[0] * steplength;
+  }
+  for (unsigned int t = 0; t < T; ++t) {
+    const boost::shared_ptr<ActionDataAbstract>& d = problem_.running_datas_[t];
+    us_try[t].noalias() = us_[t] - k_[t] * steplength - K_[t] * dx[t];
+    dx[t + 1].noalias() = d->get_Fx() * dx[t];
+    dx[t + 1].noalias() += d->get_Fu() * us_try[t];
+    dx[t + 1].noalias() -= d->get_Fu() * us_[t];
+    if (!is_feasible_) {
+      dx[t + 1] += gaps_[t + 1] * steplength;
+    }
+  }
+
+  const int N = static_cast<int>(T) + 1;
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#pragma omp parallel for num_threads(problem_.get_nthreads()) schedule(dynamic)
+#endif
+  for (int t = 0; t < N; ++t) {
+    if (t < static_cast<int>(T)) {
+      ActionModelAbstract* m = problem_.running_models_[t];
+      m->get_state().integrate(xs_[t], dx[t], xs_try[t]);
+      CROCODDYL_TRACE_SCOPE("action", "calc", NULL, t);
+      m->calc(running_datas[t], xs_try[t], us_try[t]);
+    } else {
+      ActionModelAbstract* m = problem_.terminal_model_;
+      m->get_state().integrate(xs_[t], dx[t], xs_try[t]);
+      CROCODDYL_TRACE_SCOPE("action", "calc", NULL, t);
+      m->calc(terminal_data, xs_try[t]);
+    }
+  }
+
+  // The cost is reduced in node order, and the first node that diverged is reported
+  cost_try = 0.;
+  node = -1;
+  for (unsigned int t = 0; t < T; ++t) {
+    const boost::shared_ptr<ActionDataAbstract>& d = running_datas[t];
+    cost_try += d->cost;
+    if (raiseIfNaN(cost_try) || raiseIfNaN(d->get_xnext().lpNorm<Eigen::Infinity>())) {
+      node = static_cast<int>(t);
+      return SolverStatusForwardError;
+    }
+  }
+  cost_try += terminal_data->cost;
+  if (raiseIfNaN(cost_try)) {
+    node = static_cast<int>(T);
+    return SolverStatusForwardError;
+  }
+  return SolverStatusSuccess;
+}
+
+double SolverFDDP::computeRejectionCost(const double& steplength) const {
+  // The expected improvement of an infeasible candidate depends on the rollout
+  if (cost_lb_ == -std::numeric_limits<double>::infinity() || !is_feasible_) {
+    return std::numeric_limits<double>::infinity();
+  }
+  // Without gaps, the expected improvement is given by dg and dq
+  const double dVexp = steplength * (dg_ + 0.5 * steplength * dq_);
+  if (dVexp >= 0) {
+    if (dg_ < th_grad_) {
+      return std::numeric_limits<double>::infinity();
+    }
+    return cost_ - th_acceptstep_ * dVexp;
+  }
+  return cost_ - th_acceptnegstep_ * dVexp;
+}
+
+const double& SolverFDDP::get_th_acceptnegstep() const { return th_acceptnegstep_; }
+
+const bool& SolverFDDP::get_multiple_shooting() const { return multiple_shooting_; }
+
+const double& SolverFDDP::get_th_gaptol() const { return th_gaptol_; }
+
+void SolverFDDP::set_th_acceptnegstep(const double& th_acceptnegstep) {
+  assert(th_acceptnegstep >= 0. && "th_acceptnegstep value has to be positive.");
+  th_acceptnegstep_ = th_acceptnegstep;
+}
+
+void SolverFDDP::set_multiple_shooting(const bool& multiple_shooting) { multiple_shooting_ = multiple_shooting; }
+
+void SolverFDDP::set_th_gaptol(const double& th_gaptol) {
+  assert(th_gaptol >= 0. && "th_gaptol value has to be positive.");
+  th_gaptol_ = th_gaptol;
+}
+
+}  // namespace crocoddyl
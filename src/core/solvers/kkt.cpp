@@ -0,0 +1,413 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "crocoddyl/core/solvers/kkt.hpp"
+#include <cmath>
+
+namespace crocoddyl {
+
+SolverKKT::SolverKKT(ShootingProblem& problem)
+    : SolverAbstract(problem),
+      cost_try_(0.),
+      nx_(0),
+      ndx_(0),
+      nu_(0),
+      regfactor_(10.),
+      regmin_(1e-9),
+      regmax_(1e9),
+      th_grad_(1e-12) {
+  allocateData();
+
+  const unsigned int& n_alphas = 7;
+  alphas_.resize(n_alphas);
+  for (unsigned int n = 0; n < n_alphas; ++n) {
+    alphas_[n] = 1. / pow(10., static_cast<double>(n));
+  }
+}
+
+SolverKKT::~SolverKKT() {}
+
+bool SolverKKT::solve(const std::vector<Eigen::VectorXd>& init_xs, const std::vector<Eigen::VectorXd>& init_us,
+                      const unsigned int& maxiter, const bool& is_feasible, const double& reginit) {
+  setCandidate(init_xs, init_us, is_feasible);
+  xreg_ = reginit;
+  ureg_ = reginit;
+  resetTimings();
+  resetHistory();
+  CallbackFlush flush(*this);
+
+  for (iter_ = 0; iter_ < maxiter; ++iter_) {
+    const double iter_duration = predictPhaseTime(SolverPhaseCalc) + predictPhaseTime(SolverPhaseCalcDiff) +
+                                 predictPhaseTime(SolverPhaseBackwardPass) + predictPhaseTime(SolverPhaseForwardPass);
+    if (iter_ > 0 && stopByBudget(iter_duration)) {
+      return false;
+    }
+    resetIterTimings();
+    is_accepted_ = false;
+    computeDirection(true);
+    if (status_ != SolverStatusSuccess) {
+      return false;
+    }
+    expectedImprovement();
+
+    for (std::vector<double>::const_iterator it = alphas_.begin(); it != alphas_.end(); ++it) {
+      steplength_ = *it;
+      if (stopByBudget(predictPhaseTime(SolverPhaseForwardPass))) {
+        return false;
+      }
+
+      {
+        addLineSearchTrial();
+        PhaseTimer timer(*this, SolverPhaseForwardPass);
+        dV_ = tryStep(steplength_);
+      }
+      if (status_ != SolverStatusSuccess) {
+        continue;
+      }
+      dVexp_ = steplength_ * (d_[0] + 0.5 * steplength_ * d_[1]);
+
+      // The KKT matrix is indefinite, so the Newton step might not be a descent direction (i.e. d_[0] < 0)
+      if (std::abs(d_[0]) < th_grad_ || !is_feasible_ || dV_ > th_acceptstep_ * dVexp_) {
+        setCandidate(xs_try_, us_try_, true);
+        cost_ = cost_try_;
+        is_accepted_ = true;
+        break;
+      }
+    }
+
+    // Like DDP, we regularize the Hessian until the Newton step is a descent direction, and we give up at the largest
+    // regularization
+    if (!is_accepted_) {
+      increaseRegularization();
+      if (xreg_ == regmax_) {
+        return false;
+      }
+    } else if (steplength_ == alphas_.front()) {
+      decreaseRegularization();
+    }
+    stoppingCriteria();
+
+    recordIteration();
+    const unsigned int& n_callbacks = static_cast<unsigned int>(callbacks_.size());
+    for (unsigned int c = 0; c < n_callbacks; ++c) {
+      CallbackAbstract& callback = *callbacks_[c];
+      callback(*this);
+    }
+
+    if (stop_ < th_stop_) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void SolverKKT::computeDirection(const bool& recalc) {
+  if (recalc) {
+    calc();
+  }
+  {
+    PhaseTimer timer(*this, SolverPhaseBackwardPass);
+    if (computePrimalDual() != SolverStatusSuccess) {
+      return;
+    }
+  }
+
+  const unsigned int& T = problem_.get_T();
+  for (unsigned int t = 0; t < T; ++t) {
+    const unsigned int& ndx = problem_.running_models_[t]->get_state().get_ndx();
+    const unsigned int& nu = problem_.running_models_[t]->get_nu();
+    dxs_[t] = primaldual_.segment(idx_[t], ndx);
+    dus_[t] = primaldual_.segment(idu_[t], nu);
+    lambdas_[t] = primaldual_.segment(ilambda_[t], ndx);
+  }
+  const unsigned int& ndx = problem_.terminal_model_->get_state().get_ndx();
+  dxs_.back() = primaldual_.segment(idx_.back(), ndx);
+  lambdas_.back() = primaldual_.segment(ilambda_.back(), ndx);
+}
+
+double SolverKKT::tryStep(const double& steplength) {
+  const unsigned int& T = problem_.get_T();
+  for (unsigned int t = 0; t < T; ++t) {
+    problem_.running_models_[t]->get_state().integrate(xs_[t], steplength * dxs_[t], xs_try_[t]);
+    us_try_[t] = us_[t] + steplength * dus_[t];
+  }
+  problem_.terminal_model_->get_state().integrate(xs_.back(), steplength * dxs_.back(), xs_try_.back());
+  cost_try_ = problem_.calc(xs_try_, us_try_);
+
+  if (raiseIfNaN(cost_try_)) {
+    // Looking for the first node whose cost diverged, the terminal one otherwise
+    unsigned int t = 0;
+    while (t < T && !raiseIfNaN(problem_.running_datas_[t]->cost)) {
+      ++t;
+    }
+    setStatus(SolverStatusForwardError, static_cast<int>(t));
+  } else {
+    setStatus(SolverStatusSuccess);
+  }
+  return cost_ - cost_try_;
+}
+
+double SolverKKT::stoppingCriteria() {
+  // Norm of the gradient of the Lagrangian, i.e. || Lx + J^T lambda ||^2, and of the constraint values
+  stop_ = 0.;
+  const unsigned int& T = problem_.get_T();
+  for (unsigned int t = 0; t < T; ++t) {
+    boost::shared_ptr<ActionDataAbstract>& d = problem_.running_datas_[t];
+    const unsigned int& ndx = problem_.running_models_[t]->get_state().get_ndx();
+    const unsigned int& nu = problem_.running_models_[t]->get_nu();
+    stop_ += (kktref_.segment(idx_[t], ndx) + lambdas_[t] - d->get_Fx().transpose() * lambdas_[t + 1]).squaredNorm();
+    stop_ += (kktref_.segment(idu_[t], nu) - d->get_Fu().transpose() * lambdas_[t + 1]).squaredNorm();
+    stop_ += kktref_.segment(ilambda_[t], ndx).squaredNorm();
+  }
+  const unsigned int& ndx = problem_.terminal_model_->get_state().get_ndx();
+  stop_ += (kktref_.segment(idx_.back(), ndx) + lambdas_.back()).squaredNorm();
+  stop_ += kktref_.segment(ilambda_.back(), ndx).squaredNorm();
+  return stop_;
+}
+
+const Eigen::Vector2d& SolverKKT::expectedImprovement() {
+  // Quadratic model of the cost along the primal step, i.e. -grad^T dz and -dz^T hess dz
+  d_.fill(0);
+  const unsigned int& T = problem_.get_T();
+  for (unsigned int t = 0; t < T; ++t) {
+    boost::shared_ptr<ActionDataAbstract>& d = problem_.running_datas_[t];
+    const Eigen::VectorXd& dx = dxs_[t];
+    const Eigen::VectorXd& du = dus_[t];
+    d_[0] -= d->get_Lx().dot(dx) + d->get_Lu().dot(du);
+    d_[1] -= dx.dot(d->get_Lxx() * dx) + 2 * dx.dot(d->get_Lxu() * du) + du.dot(d->get_Luu() * du);
+    if (!std::isnan(xreg_)) {
+      d_[1] -= xreg_ * dx.squaredNorm();
+    }
+    if (!std::isnan(ureg_)) {
+      d_[1] -= ureg_ * du.squaredNorm();
+    }
+  }
+  boost::shared_ptr<ActionDataAbstract>& d = problem_.terminal_data_;
+  const Eigen::VectorXd& dx = dxs_.back();
+  d_[0] -= d->get_Lx().dot(dx);
+  d_[1] -= dx.dot(d->get_Lxx() * dx);
+  if (!std::isnan(xreg_)) {
+    d_[1] -= xreg_ * dx.squaredNorm();
+  }
+  return d_;
+}
+
+double SolverKKT::calc() {
+  {
+    PhaseTimer timer(*this, SolverPhaseCalc);
+    problem_.calc(xs_, us_);
+  }
+  {
+    PhaseTimer timer(*this, SolverPhaseCalcDiff);
+    cost_ = problem_.calcDiff(xs_, us_, false);
+  }
+  addLinearizations();
+
+  // Constraint value of the initial state, i.e. x_guess - x_ref = diff(x_ref, x_guess)
+  const unsigned int& ndx0 = problem_.running_models_[0]->get_state().get_ndx();
+  problem_.running_models_[0]->get_state().diff(problem_.get_x0(), xs_[0], kktref_.segment(ilambda_[0], ndx0));
+
+  const unsigned int& T = problem_.get_T();
+  for (unsigned int t = 0; t < T; ++t) {
+    ActionModelAbstract* m = problem_.running_models_[t];
+    boost::shared_ptr<ActionDataAbstract>& d = problem_.running_datas_[t];
+    const unsigned int& ndx = m->get_state().get_ndx();
+    const unsigned int& nu = m->get_nu();
+
+    // Hessian and gradient of the cost
+    setBlock(idx_[t], idx_[t], d->get_Lxx());
+    setBlock(idx_[t], idu_[t], d->get_Lxu());
+    setBlock(idu_[t], idx_[t], d->get_Lxu(), 1., true);
+    setBlock(idu_[t], idu_[t], d->get_Luu());
+    if (!std::isnan(xreg_)) {
+      setDiagonal(idx_[t], idx_[t], ndx, xreg_);
+    }
+    if (!std::isnan(ureg_)) {
+      setDiagonal(idu_[t], idu_[t], nu, ureg_);
+    }
+    kktref_.segment(idx_[t], ndx) = d->get_Lx();
+    kktref_.segment(idu_[t], nu) = d->get_Lu();
+
+    // Jacobian of the dynamics constraint, i.e. dx_{t+1} - Fx dx_t - Fu du_t
+    setBlock(ilambda_[t + 1], idx_[t], d->get_Fx(), -1.);
+    setBlock(ilambda_[t + 1], idu_[t], d->get_Fu(), -1.);
+    setBlock(idx_[t], ilambda_[t + 1], d->get_Fx(), -1., true);
+    setBlock(idu_[t], ilambda_[t + 1], d->get_Fu(), -1., true);
+
+    // Constraint value, i.e. xnext_guess - f(x_guess, u_guess) = diff(f, xnext_guess)
+    m->get_state().diff(d->get_xnext(), xs_[t + 1], kktref_.segment(ilambda_[t + 1], ndx));
+  }
+
+  boost::shared_ptr<ActionDataAbstract>& d = problem_.terminal_data_;
+  const unsigned int& ndx = problem_.terminal_model_->get_state().get_ndx();
+  setBlock(idx_.back(), idx_.back(), d->get_Lxx());
+  if (!std::isnan(xreg_)) {
+    setDiagonal(idx_.back(), idx_.back(), ndx, xreg_);
+  }
+  kktref_.segment(idx_.back(), ndx) = d->get_Lx();
+  return cost_;
+}
+
+SolverStatus SolverKKT::computePrimalDual() {
+  kkt_lu_.factorize(kkt_);
+  if (kkt_lu_.info() != Eigen::Success) {
+    return setStatus(SolverStatusBackwardError);
+  }
+  primaldual_ = kkt_lu_.solve(kktref_);
+  primaldual_ *= -1.;
+  return setStatus(SolverStatusSuccess);
+}
+
+void SolverKKT::increaseRegularization() {
+  // Without regularization (i.e. NaN or zero), we start from the smallest one
+  if (std::isnan(xreg_) || xreg_ < regmin_) {
+    xreg_ = regmin_;
+  } else {
+    xreg_ *= regfactor_;
+  }
+  if (xreg_ > regmax_) {
+    xreg_ = regmax_;
+  }
+  ureg_ = xreg_;
+}
+
+void SolverKKT::decreaseRegularization() {
+  // We never go below the initial regularization if it is smaller than the minimum one
+  if (xreg_ > regmin_) {
+    xreg_ /= regfactor_;
+    if (xreg_ < regmin_) {
+      xreg_ = regmin_;
+    }
+    ureg_ = xreg_;
+  }
+}
+
+void SolverKKT::setBlock(const unsigned int& row, const unsigned int& col, const Eigen::MatrixXd& block,
+                         const double& sign, const bool& transpose) {
+  const long nrows = transpose ? block.cols() : block.rows();
+  const long ncols = transpose ? block.rows() : block.cols();
+  for (long j = 0; j < ncols; ++j) {
+    // The pattern is fixed, so we only need to walk along the non-zeros of the column
+    for (Eigen::SparseMatrix<double>::InnerIterator it(kkt_, col + j); it; ++it) {
+      const long i = it.row() - row;
+      if (i >= 0 && i < nrows) {
+        it.valueRef() = transpose ? sign * block(j, i) : sign * block(i, j);
+      }
+    }
+  }
+}
+
+void SolverKKT::setDiagonal(const unsigned int& row, const unsigned int& col, const unsigned int& n,
+                            const double& value) {
+  for (unsigned int i = 0; i < n; ++i) {
+    kkt_.coeffRef(row + i, col + i) += value;
+  }
+}
+
+void SolverKKT::allocateData() {
+  const unsigned int& T = problem_.get_T();
+  xs_try_.resize(T + 1);
+  us_try_.resize(T);
+  dxs_.resize(T + 1);
+  dus_.resize(T);
+  lambdas_.resize(T + 1);
+  ilambda_.resize(T + 1);
+  idx_.resize(T + 1);
+  idu_.resize(T);
+
+  // Stage-wise ordering of the KKT rows and columns: (lambda_0, dx_0, du_0, lambda_1, dx_1, du_1, ...)
+  nx_ = 0;
+  ndx_ = 0;
+  nu_ = 0;
+  unsigned int ix = 0;
+  for (unsigned int t = 0; t < T; ++t) {
+    ActionModelAbstract* model = problem_.running_models_[t];
+    const unsigned int& nx = model->get_state().get_nx();
+    const unsigned int& ndx = model->get_state().get_ndx();
+    const unsigned int& nu = model->get_nu();
+
+    ilambda_[t] = ix;
+    idx_[t] = ix + ndx;
+    idu_[t] = ix + 2 * ndx;
+    ix += 2 * ndx + nu;
+    nx_ += nx;
+    ndx_ += ndx;
+    nu_ += nu;
+
+    xs_try_[t] = model->get_state().zero();
+    us_try_[t] = Eigen::VectorXd::Zero(nu);
+    dxs_[t] = Eigen::VectorXd::Zero(ndx);
+    dus_[t] = Eigen::VectorXd::Zero(nu);
+    lambdas_[t] = Eigen::VectorXd::Zero(ndx);
+  }
+  StateAbstract& terminal_state = problem_.terminal_model_->get_state();
+  const unsigned int& ndx = terminal_state.get_ndx();
+  ilambda_.back() = ix;
+  idx_.back() = ix + ndx;
+  ix += 2 * ndx;
+  nx_ += terminal_state.get_nx();
+  ndx_ += ndx;
+  xs_try_.back() = terminal_state.zero();
+  dxs_.back() = Eigen::VectorXd::Zero(ndx);
+  lambdas_.back() = Eigen::VectorXd::Zero(ndx);
+
+  // Sparsity pattern of the KKT matrix. Note that the identity blocks of the dynamics constraints are constant
+  std::vector<Eigen::Triplet<double> > triplets;
+  for (unsigned int t = 0; t < T + 1; ++t) {
+    const bool terminal = t == T;
+    const unsigned int& ndx = terminal ? terminal_state.get_ndx() : problem_.running_models_[t]->get_state().get_ndx();
+    const unsigned int nu = terminal ? 0 : problem_.running_models_[t]->get_nu();
+    const unsigned int nz = ndx + nu;  // dx_t and du_t are contiguous
+    for (unsigned int i = 0; i < nz; ++i) {
+      for (unsigned int j = 0; j < nz; ++j) {
+        triplets.push_back(Eigen::Triplet<double>(idx_[t] + i, idx_[t] + j, 0.));
+      }
+    }
+    for (unsigned int i = 0; i < ndx; ++i) {
+      triplets.push_back(Eigen::Triplet<double>(ilambda_[t] + i, idx_[t] + i, 1.));
+      triplets.push_back(Eigen::Triplet<double>(idx_[t] + i, ilambda_[t] + i, 1.));
+    }
+    if (!terminal) {
+      const unsigned int& ndx_next = t + 1 == T ? terminal_state.get_ndx()
+                                                : problem_.running_models_[t + 1]->get_state().get_ndx();
+      for (unsigned int i = 0; i < ndx_next; ++i) {
+        for (unsigned int j = 0; j < nz; ++j) {
+          triplets.push_back(Eigen::Triplet<double>(ilambda_[t + 1] + i, idx_[t] + j, 0.));
+          triplets.push_back(Eigen::Triplet<double>(idx_[t] + j, ilambda_[t + 1] + i, 0.));
+        }
+      }
+    }
+  }
+  kkt_.resize(ix, ix);
+  kkt_.setFromTriplets(triplets.begin(), triplets.end());
+  kkt_.makeCompressed();
+  kkt_lu_.analyzePattern(kkt_);
+
+  kktref_ = Eigen::VectorXd::Zero(ix);
+  primaldual_ = Eigen::VectorXd::Zero(ix);
+}
+
+const Eigen::SparseMatrix<double>& SolverKKT::get_kkt() const { return kkt_; }
+
+const Eigen::VectorXd& SolverKKT::get_kktref() const { return kktref_; }
+
+const Eigen::VectorXd& SolverKKT::get_primaldual() const { return primaldual_; }
+
+const std::vector<Eigen::VectorXd>& SolverKKT::get_dxs() const { return dxs_; }
+
+const std::vector<Eigen::VectorXd>& SolverKKT::get_dus() const { return dus_; }
+
+const std::vector<Eigen::VectorXd>& SolverKKT::get_lambdas() const { return lambdas_; }
+
+const unsigned int& SolverKKT::get_nx() const { return nx_; }
+
+const unsigned int& SolverKKT::get_ndx() const { return ndx_; }
+
+const unsigned int& SolverKKT::get_nu() const { return nu_; }
+
+}  // namespace crocoddyl
@@ -10,12 +10,14 @@
 
 namespace crocoddyl {
 
-CallbackVerbose::CallbackVerbose(VerboseLevel level) : CallbackAbstract(), level(level) {}
+namespace {
 
-CallbackVerbose::~CallbackVerbose() {}
+#ifdef CROCODDYL_WITH_ASYNC_CALLBACKS
+const long DISPATCH_PERIOD = 100;  // sleep of the dispatcher thread when the ring is empty [us]
+#endif
 
-void CallbackVerbose::operator()(SolverAbstract& solver) {
-  if (solver.get_iter() % 10 == 0) {
+void printIteration(const IterationRecord& record, const VerboseLevel& level) {
+  if (record.iter % 10 == 0) {
     switch (level) {
       case _1: {
         std::cout << "iter \t cost \t      stop \t    grad \t  xreg";
@@ -36,34 +38,135 @@ void CallbackVerbose::operator()(SolverAbstract& solver) {
 
   switch (level) {
     case _1: {
-      std::cout << std::setw(4) << solver.get_iter() << "  ";
-      std::cout << std::scientific << std::setprecision(5) << solver.get_cost() << "  ";
-      std::cout << solver.get_stop() << "  " << -solver.get_d()[1] << "  ";
-      std::cout << solver.get_xreg() << "  " << solver.get_ureg() << "   ";
-      std::cout << std::fixed << std::setprecision(4) << solver.get_stepLength() << "     ";
-      std::cout << solver.get_isFeasible() << '\n';
+      std::cout << std::setw(4) << record.iter << "  ";
+      std::cout << std::scientific << std::setprecision(5) << record.cost << "  ";
+      std::cout << record.stop << "  " << -record.d[1] << "  ";
+      std::cout << record.xreg << "  " << record.ureg << "   ";
+      std::cout << std::fixed << std::setprecision(4) << record.steplength << "     ";
+      std::cout << record.is_feasible << '\n';
       break;
     }
     case _2: {
-      std::cout << std::setw(4) << solver.get_iter() << "  ";
-      std::cout << std::scientific << std::setprecision(5) << solver.get_cost() << "  ";
-      std::cout << solver.get_stop() << "  " << -solver.get_d()[1] << "  ";
-      std::cout << solver.get_xreg() << "  " << solver.get_ureg() << "   ";
-      std::cout << std::fixed << std::setprecision(4) << solver.get_stepLength() << "     ";
-      std::cout << solver.get_isFeasible() << "  ";
-      std::cout << std::scientific << std::setprecision(5) << solver.get_dV() << "  ";
-      std::cout << solver.get_dVexp() << '\n';
+      std::cout << std::setw(4) << record.iter << "  ";
+      std::cout << std::scientific << std::setprecision(5) << record.cost << "  ";
+      std::cout << record.stop << "  " << -record.d[1] << "  ";
+      std::cout << record.xreg << "  " << record.ureg << "   ";
+      std::cout << std::fixed << std::setprecision(4) << record.steplength << "     ";
+      std::cout << record.is_feasible << "  ";
+      std::cout << std::scientific << std::setprecision(5) << record.dV << "  ";
+      std::cout << record.dVexp << '\n';
       break;
     }
     default: {
-      std::cout << std::setw(4) << solver.get_iter() << "  ";
-      std::cout << std::scientific << std::setprecision(5) << solver.get_cost() << "  ";
-      std::cout << solver.get_stop() << "  " << -solver.get_d()[1] << "  ";
-      std::cout << solver.get_xreg() << "  " << solver.get_ureg() << "   ";
-      std::cout << std::fixed << std::setprecision(4) << solver.get_stepLength() << "     ";
-      std::cout << solver.get_isFeasible() << '\n';
+      std::cout << std::setw(4) << record.iter << "  ";
+      std::cout << std::scientific << std::setprecision(5) << record.cost << "  ";
+      std::cout << record.stop << "  " << -record.d[1] << "  ";
+      std::cout << record.xreg << "  " << record.ureg << "   ";
+      std::cout << std::fixed << std::setprecision(4) << record.steplength << "     ";
+      std::cout << record.is_feasible << '\n';
+    }
+  }
+}
+
+}  // namespace
+
+CallbackVerbose::CallbackVerbose(VerboseLevel level) : CallbackAbstract(), level(level) {}
+
+CallbackVerbose::~CallbackVerbose() {}
+
+void CallbackVerbose::operator()(SolverAbstract& solver) {
+  IterationRecord record;
+  record.update(solver);
+  printIteration(record, level);
+}
+
+void IterationRecord::update(const SolverAbstract& solver) {
+  iter = solver.get_iter();
+  cost = solver.get_cost();
+  stop = solver.get_stop();
+  d[0] = solver.get_d()[0];
+  d[1] = solver.get_d()[1];
+  xreg = solver.get_xreg();
+  ureg = solver.get_ureg();
+  steplength = solver.get_stepLength();
+  dV = solver.get_dV();
+  dVexp = solver.get_dVexp();
+  is_feasible = solver.get_isFeasible();
+  is_accepted = solver.get_isAccepted();
+  timings = solver.get_iterTimings();
+}
+
+IterationCallbackVerbose::IterationCallbackVerbose(VerboseLevel level) : IterationCallbackAbstract(), level(level) {}
+
+IterationCallbackVerbose::~IterationCallbackVerbose() {}
+
+void IterationCallbackVerbose::operator()(const IterationRecord& record) { printIteration(record, level); }
+
+#ifdef CROCODDYL_WITH_ASYNC_CALLBACKS
+CallbackAsync::CallbackAsync(const std::size_t& capacity)
+    : CallbackAbstract(), records_(capacity), capacity_(capacity), head_(0), tail_(0), running_(true), dropped_(0) {
+  assert(capacity > 0 && "The capacity has to be positive");
+  thread_ = boost::thread(&CallbackAsync::dispatch, this);
+}
+
+CallbackAsync::~CallbackAsync() {
+  running_.store(false, boost::memory_order_release);
+  thread_.join();
+}
+
+void CallbackAsync::operator()(SolverAbstract& solver) {
+  const boost::uint64_t head = head_.load(boost::memory_order_relaxed);
+  if (head - tail_.load(boost::memory_order_acquire) >= capacity_) {
+    ++dropped_;
+    return;
+  }
+  records_[head % capacity_].update(solver);
+  head_.store(head + 1, boost::memory_order_release);
+}
+
+void CallbackAsync::flush() {
+  const boost::uint64_t head = head_.load(boost::memory_order_relaxed);
+  while (tail_.load(boost::memory_order_acquire) != head) {
+    boost::this_thread::yield();
+  }
+}
+
+void CallbackAsync::setCallbacks(const std::vector<IterationCallbackAbstract*>& callbacks) {
+  flush();
+  boost::mutex::scoped_lock lock(callbacks_mutex_);
+  callbacks_ = callbacks;
+}
+
+const std::size_t& CallbackAsync::get_capacity() const { return capacity_; }
+
+const boost::uint64_t& CallbackAsync::get_dropped() const { return dropped_; }
+
+boost::uint64_t CallbackAsync::get_dispatched() const { return tail_.load(boost::memory_order_acquire); }
+
+void CallbackAsync::dispatch() {
+  while (true) {
+    // The queued records are dispatched before stopping
+    const bool running = running_.load(boost::memory_order_acquire);
+    const boost::uint64_t tail = tail_.load(boost::memory_order_relaxed);
+    if (tail == head_.load(boost::memory_order_acquire)) {
+      if (!running) {
+        break;
+      }
+      boost::this_thread::sleep(boost::posix_time::microseconds(DISPATCH_PERIOD));
+      continue;
+    }
+    {
+      boost::mutex::scoped_lock lock(callbacks_mutex_);
+      const IterationRecord& record = records_[tail % capacity_];
+      const std::size_t& n_callbacks = callbacks_.size();
+      for (std::size_t c = 0; c < n_callbacks; ++c) {
+        (*callbacks_[c])(record);
+      }
     }
+    // The slot is released once the callbacks are done with it
+    tail_.store(tail + 1, boost::memory_order_release);
   }
 }
+#endif  // CROCODDYL_WITH_ASYNC_CALLBACKS
 
 }  // namespace crocoddyl
@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "crocoddyl/core/utils/policy.hpp"
+#include <algorithm>
+
+namespace crocoddyl {
+
+PolicyPublisher::PolicyPublisher(SolverDDP& solver, const double& dt)
+    : CallbackAbstract(), solver_(solver), published_(1), back_(0), front_(2), time_(0.), dt_(dt), sequence_(0) {
+  const ShootingProblem& problem = solver_.get_problem();
+  const unsigned int& T = problem.get_T();
+  for (std::size_t i = 0; i < 3; ++i) {
+    PolicySnapshot& buffer = buffers_[i];
+    buffer.xs.resize(T + 1);
+    buffer.us.resize(T);
+    buffer.K.resize(T);
+    buffer.ts.resize(T + 1, 0.);
+    for (unsigned int t = 0; t < T; ++t) {
+      const ActionModelAbstract* model = problem.running_models_[t];
+      buffer.xs[t] = Eigen::VectorXd::Zero(model->get_state().get_nx());
+      buffer.us[t] = Eigen::VectorXd::Zero(model->get_nu());
+      buffer.K[t] = Eigen::MatrixXd::Zero(model->get_nu(), model->get_state().get_ndx());
+    }
+    buffer.xs.back() = Eigen::VectorXd::Zero(problem.terminal_model_->get_state().get_nx());
+    buffer.cost = 0.;
+    buffer.iter = 0;
+    buffer.sequence = 0;
+  }
+}
+
+PolicyPublisher::~PolicyPublisher() {}
+
+void PolicyPublisher::operator()(SolverAbstract& solver) {
+  assert(&solver == &solver_ && "the publisher is called by another solver");
+  if (solver.get_isAccepted()) {
+    publish();
+  }
+}
+
+void PolicyPublisher::publish() {
+  PolicySnapshot& buffer = buffers_[back_];
+  const std::size_t T = buffer.us.size();
+  assert(solver_.get_problem().get_T() == T && "the horizon of the problem has changed");
+  const std::vector<Eigen::VectorXd>& xs = solver_.get_xs();
+  const std::vector<Eigen::VectorXd>& us = solver_.get_us();
+  const std::vector<SolverDDP::MatrixMap>& K = solver_.get_K_map();
+  for (std::size_t t = 0; t < T; ++t) {
+    buffer.xs[t] = xs[t];
+    buffer.us[t] = us[t];
+    buffer.K[t] = K[t];
+    buffer.ts[t] = time_ + static_cast<double>(t) * dt_;
+  }
+  buffer.xs[T] = xs[T];
+  buffer.ts[T] = time_ + static_cast<double>(T) * dt_;
+  buffer.cost = solver_.get_cost();
+  buffer.iter = solver_.get_iter();
+  buffer.sequence = ++sequence_;
+
+  // Publishing the written buffer, and taking back the previously published one (or the one left by the reader)
+  back_ = published_.exchange(static_cast<unsigned char>(back_ | UPDATED), boost::memory_order_acq_rel) & 3;
+}
+
+const PolicySnapshot& PolicyPublisher::read() {
+  if (published_.load(boost::memory_order_acquire) & UPDATED) {
+    front_ = published_.exchange(front_, boost::memory_order_acq_rel) & 3;
+  }
+  return buffers_[front_];
+}
+
+bool PolicyPublisher::has_update() const { return (published_.load(boost::memory_order_acquire) & UPDATED) != 0; }
+
+const double& PolicyPublisher::get_time() const { return time_; }
+
+const double& PolicyPublisher::get_dt() const { return dt_; }
+
+void PolicyPublisher::set_time(const double& time) { time_ = time; }
+
+void PolicyPublisher::set_dt(const double& dt) {
+  assert(dt > 0. && "dt has to be positive");
+  dt_ = dt;
+}
+
+PolicyEvaluator::PolicyEvaluator(ShootingProblem& problem) {
+  const unsigned int& T = problem.get_T();
+  for (unsigned int t = 0; t < T; ++t) {
+    ActionModelAbstract* model = problem.running_models_[t];
+    states_.push_back(&model->get_state());
+    dx_.push_back(Eigen::VectorXd::Zero(model->get_state().get_ndx()));
+    u_.push_back(Eigen::VectorXd::Zero(model->get_nu()));
+  }
+}
+
+PolicyEvaluator::~PolicyEvaluator() {}
+
+void PolicyEvaluator::evaluate(const PolicySnapshot& policy, const double& time,
+                               const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> u) {
+  const std::size_t T = policy.us.size();
+  assert(T > 0 && T == states_.size() && "the policy has a wrong number of nodes");
+  assert(policy.sequence > 0 && "nothing was published yet");
+  const std::vector<double>& ts = policy.ts;
+  if (time <= ts[0]) {
+    evaluateNode(policy, 0, x, u);
+    return;
+  }
+  if (time >= ts[T - 1]) {
+    evaluateNode(policy, T - 1, x, u);
+    return;
+  }
+
+  // Node before the given time, i.e. ts[t] <= time < ts[t + 1]
+  const std::size_t t = static_cast<std::size_t>(std::upper_bound(ts.begin(), ts.begin() + T, time) - ts.begin()) - 1;
+  evaluateNode(policy, t, x, u);
+  if (u_[t + 1].size() == u.size()) {
+    const double alpha = (time - ts[t]) / (ts[t + 1] - ts[t]);
+    evaluateNode(policy, t + 1, x, u_[t + 1]);
+    u *= 1. - alpha;
+    u += alpha * u_[t + 1];
+  }
+}
+
+void PolicyEvaluator::evaluateNode(const PolicySnapshot& policy, const std::size_t& t,
+                                   const Eigen::Ref<const Eigen::VectorXd>& x, Eigen::Ref<Eigen::VectorXd> u) {
+  states_[t]->diff(policy.xs[t], x, dx_[t]);
+  u = policy.us[t];
+  u.noalias() -= policy.K[t] * dx_[t];
+}
+
+}  // namespace crocoddyl
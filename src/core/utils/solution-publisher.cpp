@@ -0,0 +1,247 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "crocoddyl/core/utils/solution-publisher.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace crocoddyl {
+
+namespace {
+
+const boost::uint32_t SOLUTION_RING_MAGIC = 0x43524f43;  // "CROC"
+const boost::uint32_t SOLUTION_RING_VERSION = 1;
+const std::size_t CACHE_LINE = 64;
+const unsigned int READ_ATTEMPTS = 4;
+
+std::size_t alignToCacheLine(const std::size_t& size) { return (size + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE; }
+
+const SolutionSlot* slotAt(const SolutionRing* ring, const boost::uint64_t& index) {
+  const char* base = reinterpret_cast<const char*>(ring) + alignToCacheLine(sizeof(SolutionRing));
+  return reinterpret_cast<const SolutionSlot*>(base + (index % ring->capacity) * ring->slot_size);
+}
+
+SolutionSlot* slotAt(SolutionRing* ring, const boost::uint64_t& index) {
+  return const_cast<SolutionSlot*>(slotAt(const_cast<const SolutionRing*>(ring), index));
+}
+
+const double* slotData(const SolutionSlot* slot) {
+  return reinterpret_cast<const double*>(reinterpret_cast<const char*>(slot) + sizeof(SolutionSlot));
+}
+
+double* slotData(SolutionSlot* slot) {
+  return reinterpret_cast<double*>(reinterpret_cast<char*>(slot) + sizeof(SolutionSlot));
+}
+
+}  // namespace
+
+SolutionPublisher::SolutionPublisher(const std::string& name, const ShootingProblem& problem,
+                                     const std::size_t& capacity)
+    : CallbackAbstract(), name_(name), capacity_(capacity), size_(0), ring_(NULL) {
+  assert(capacity > 0 && "The capacity has to be positive");
+  const unsigned int& T = problem.get_T();
+  boost::uint32_t nxs = problem.terminal_model_->get_state().get_nx();
+  boost::uint32_t nus = 0;
+  for (unsigned int t = 0; t < T; ++t) {
+    nxs += problem.running_models_[t]->get_state().get_nx();
+    nus += problem.running_models_[t]->get_nu();
+  }
+  const std::size_t slot_size = alignToCacheLine(sizeof(SolutionSlot) + sizeof(double) * (nxs + nus));
+  size_ = alignToCacheLine(sizeof(SolutionRing)) + capacity_ * slot_size;
+
+  // The readers of other processes cannot share the atomics if they rely on a lock
+  boost::atomic<boost::uint64_t> sequence;
+  if (!sequence.is_lock_free()) {
+    std::cout << "Warning: the atomics aren't lock-free, we cannot publish the solutions" << std::endl;
+    return;
+  }
+  // A segment left with the same name (e.g. by a previous publisher) may still be mapped by its readers, so it is
+  // unlinked instead of truncated. The readers keep their mapping of the old segment, and the new one is created
+  // exclusively
+  shm_unlink(name_.c_str());
+  const int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd == -1) {
+    std::cout << "Warning: the shared memory " << name_ << " cannot be opened" << std::endl;
+    return;
+  }
+  void* memory = MAP_FAILED;
+  if (ftruncate(fd, static_cast<off_t>(size_)) == 0) {
+    memory = mmap(NULL, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (memory == MAP_FAILED) {
+    std::cout << "Warning: the shared memory " << name_ << " cannot be mapped" << std::endl;
+    shm_unlink(name_.c_str());
+    return;
+  }
+
+  ring_ = new (memory) SolutionRing();
+  ring_->version = SOLUTION_RING_VERSION;
+  ring_->T = T;
+  ring_->nxs = nxs;
+  ring_->nus = nus;
+  ring_->capacity = static_cast<boost::uint32_t>(capacity_);
+  ring_->slot_size = slot_size;
+  ring_->published.store(0);
+  for (std::size_t i = 0; i < capacity_; ++i) {
+    SolutionSlot* slot = new (slotAt(ring_, i)) SolutionSlot();
+    slot->sequence.store(0);
+  }
+  // The readers check the magic number once the ring is initialized
+  boost::atomic_thread_fence(boost::memory_order_release);
+  ring_->magic = SOLUTION_RING_MAGIC;
+}
+
+SolutionPublisher::~SolutionPublisher() {
+  if (ring_ != NULL) {
+    munmap(ring_, size_);
+    shm_unlink(name_.c_str());
+  }
+}
+
+void SolutionPublisher::operator()(SolverAbstract& solver) {
+  if (solver.get_isAccepted()) {
+    publish(solver);
+  }
+}
+
+void SolutionPublisher::publish(const SolverAbstract& solver) {
+  if (ring_ == NULL) {
+    return;
+  }
+  const boost::uint64_t index = ring_->published.load(boost::memory_order_relaxed);
+  SolutionSlot* slot = slotAt(ring_, index);
+  const boost::uint64_t sequence = slot->sequence.load(boost::memory_order_relaxed);
+  slot->sequence.store(sequence + 1, boost::memory_order_relaxed);
+  boost::atomic_thread_fence(boost::memory_order_release);
+
+  SolutionStats& stats = slot->stats;
+  stats.index = index;
+  stats.cost = solver.get_cost();
+  stats.stop = solver.get_stop();
+  stats.xreg = solver.get_xreg();
+  stats.ureg = solver.get_ureg();
+  stats.steplength = solver.get_stepLength();
+  stats.dV = solver.get_dV();
+  stats.dVexp = solver.get_dVexp();
+  stats.iter = solver.get_iter();
+  stats.feasible = solver.get_isFeasible();
+  double* data = slotData(slot);
+  const std::vector<Eigen::VectorXd>& xs = solver.get_xs();
+  const std::vector<Eigen::VectorXd>& us = solver.get_us();
+  for (std::size_t t = 0; t < xs.size(); ++t) {
+    data = std::copy(xs[t].data(), xs[t].data() + xs[t].size(), data);
+  }
+  for (std::size_t t = 0; t < us.size(); ++t) {
+    data = std::copy(us[t].data(), us[t].data() + us[t].size(), data);
+  }
+  assert(data == slotData(slot) + ring_->nxs + ring_->nus && "the dimension of the problem has changed");
+
+  slot->sequence.store(sequence + 2, boost::memory_order_release);
+  ring_->published.store(index + 1, boost::memory_order_release);
+}
+
+bool SolutionPublisher::is_open() const { return ring_ != NULL; }
+
+const std::string& SolutionPublisher::get_name() const { return name_; }
+
+const std::size_t& SolutionPublisher::get_capacity() const { return capacity_; }
+
+boost::uint64_t SolutionPublisher::get_published() const {
+  return ring_ == NULL ? 0 : ring_->published.load(boost::memory_order_acquire);
+}
+
+SolutionReader::SolutionReader(const std::string& name) : size_(0), ring_(NULL) {
+  const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd == -1) {
+    std::cout << "Warning: the shared memory " << name << " cannot be opened" << std::endl;
+    return;
+  }
+  struct stat status;
+  void* memory = MAP_FAILED;
+  if (fstat(fd, &status) == 0 && static_cast<std::size_t>(status.st_size) >= sizeof(SolutionRing)) {
+    size_ = static_cast<std::size_t>(status.st_size);
+    memory = mmap(NULL, size_, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (memory == MAP_FAILED) {
+    std::cout << "Warning: the shared memory " << name << " cannot be mapped" << std::endl;
+    return;
+  }
+
+  const SolutionRing* ring = static_cast<const SolutionRing*>(memory);
+  const bool is_valid = ring->magic == SOLUTION_RING_MAGIC && ring->version == SOLUTION_RING_VERSION;
+  boost::atomic_thread_fence(boost::memory_order_acquire);
+  if (!is_valid || alignToCacheLine(sizeof(SolutionRing)) + ring->capacity * ring->slot_size > size_) {
+    std::cout << "Warning: the shared memory " << name << " isn't a ring of solutions" << std::endl;
+    munmap(memory, size_);
+    return;
+  }
+  ring_ = ring;
+}
+
+SolutionReader::~SolutionReader() {
+  if (ring_ != NULL) {
+    munmap(const_cast<SolutionRing*>(ring_), size_);
+  }
+}
+
+bool SolutionReader::read_last(SolutionStats& stats, Eigen::VectorXd& xs, Eigen::VectorXd& us) const {
+  const boost::uint64_t published = get_published();
+  return published > 0 && read(published - 1, stats, xs, us);
+}
+
+bool SolutionReader::read(const boost::uint64_t& index, SolutionStats& stats, Eigen::VectorXd& xs,
+                          Eigen::VectorXd& us) const {
+  const boost::uint64_t published = get_published();
+  if (index >= published || published - index > ring_->capacity) {
+    return false;
+  }
+  xs.resize(ring_->nxs);
+  us.resize(ring_->nus);
+  const SolutionSlot* slot = slotAt(ring_, index);
+  const double* data = slotData(slot);
+
+  // The slot is copied again if the publisher wrote it meanwhile, and it is skipped if the publisher keeps writing it
+  for (unsigned int i = 0; i < READ_ATTEMPTS; ++i) {
+    const boost::uint64_t sequence = slot->sequence.load(boost::memory_order_acquire);
+    if (sequence % 2 == 1) {
+      continue;
+    }
+    std::memcpy(&stats, &slot->stats, sizeof(SolutionStats));
+    std::memcpy(xs.data(), data, sizeof(double) * ring_->nxs);
+    std::memcpy(us.data(), data + ring_->nxs, sizeof(double) * ring_->nus);
+    boost::atomic_thread_fence(boost::memory_order_acquire);
+    if (slot->sequence.load(boost::memory_order_relaxed) == sequence) {
+      return stats.index == index;
+    }
+  }
+  return false;
+}
+
+bool SolutionReader::is_open() const { return ring_ != NULL; }
+
+boost::uint64_t SolutionReader::get_published() const {
+  return ring_ == NULL ? 0 : ring_->published.load(boost::memory_order_acquire);
+}
+
+unsigned int SolutionReader::get_T() const { return ring_ == NULL ? 0 : ring_->T; }
+
+unsigned int SolutionReader::get_nxs() const { return ring_ == NULL ? 0 : ring_->nxs; }
+
+unsigned int SolutionReader::get_nus() const { return ring_ == NULL ? 0 : ring_->nus; }
+
+unsigned int SolutionReader::get_capacity() const { return ring_ == NULL ? 0 : ring_->capacity; }
+
+}  // namespace crocoddyl
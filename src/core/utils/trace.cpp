@@ -0,0 +1,131 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "crocoddyl/core/utils/trace.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#ifdef CROCODDYL_WITH_MULTITHREADING
+#include <omp.h>
+#endif
+
+namespace crocoddyl {
+
+namespace {
+
+void dumpString(std::ostream& os, const char* str) {
+  os << '"';
+  for (const char* c = str; *c != '\0'; ++c) {
+    if (*c == '"' || *c == '\\') {
+      os << '\\';
+    }
+    os << *c;
+  }
+  os << '"';
+}
+
+}  // namespace
+
+TraceRecorder::TraceRecorder(const std::size_t& capacity) : events_(capacity), size_(0), enabled_(true) { clear(); }
+
+TraceRecorder::~TraceRecorder() {}
+
+TraceRecorder& TraceRecorder::get_instance() {
+  static TraceRecorder recorder;
+  return recorder;
+}
+
+void TraceRecorder::record(const char* category, const char* name, const char* function, const int& node,
+                           const double& start, const double& duration) {
+  const std::size_t i = size_.fetch_add(1, boost::memory_order_relaxed);
+  if (i >= events_.size()) {
+    return;
+  }
+  TraceEvent& event = events_[i];
+  event.category = category;
+  event.name = name;
+  event.function = function;
+  event.node = node;
+#ifdef CROCODDYL_WITH_MULTITHREADING
+  event.thread = omp_get_thread_num();
+#else
+  event.thread = 0;
+#endif
+  event.start = start;
+  event.duration = duration;
+}
+
+void TraceRecorder::clear() {
+  size_.store(0);
+  clock_gettime(CLOCK_MONOTONIC, &origin_);
+}
+
+void TraceRecorder::dump(std::ostream& os) const {
+  const std::size_t n = get_size();
+  os << "{\"traceEvents\":[" << std::endl << std::fixed << std::setprecision(3);
+  for (std::size_t i = 0; i < n; ++i) {
+    const TraceEvent& event = events_[i];
+    os << "{\"name\":";
+    dumpString(os, event.name);
+    os << ",\"cat\":";
+    dumpString(os, event.category);
+    os << ",\"ph\":\"X\",\"ts\":" << event.start << ",\"dur\":" << event.duration << ",\"pid\":0,\"tid\":"
+       << event.thread << ",\"args\":{";
+    if (event.function != NULL) {
+      os << "\"function\":";
+      dumpString(os, event.function);
+      if (event.node >= 0) {
+        os << ",";
+      }
+    }
+    if (event.node >= 0) {
+      os << "\"node\":" << event.node;
+    }
+    os << "}}" << (i + 1 < n ? "," : "") << std::endl;
+  }
+  os << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+}
+
+void TraceRecorder::dump(const std::string& filename) const {
+  std::ofstream file(filename.c_str());
+  if (!file.is_open()) {
+    std::cout << "Warning: the trace file " << filename << " cannot be opened" << std::endl;
+    return;
+  }
+  dump(file);
+}
+
+double TraceRecorder::now() const {
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return 1e6 * static_cast<double>(now.tv_sec - origin_.tv_sec) +
+         1e-3 * static_cast<double>(now.tv_nsec - origin_.tv_nsec);
+}
+
+const bool& TraceRecorder::get_enabled() const { return enabled_; }
+
+std::size_t TraceRecorder::get_size() const { return std::min(size_.load(), events_.size()); }
+
+std::size_t TraceRecorder::get_capacity() const { return events_.size(); }
+
+std::size_t TraceRecorder::get_dropped() const {
+  const std::size_t size = size_.load();
+  return size > events_.size() ? size - events_.size() : 0;
+}
+
+const std::vector<TraceEvent>& TraceRecorder::get_events() const { return events_; }
+
+void TraceRecorder::set_enabled(const bool& enabled) { enabled_ = enabled; }
+
+void TraceRecorder::set_capacity(const std::size_t& capacity) {
+  events_.resize(capacity);
+  clear();
+}
+
+}  // namespace crocoddyl
@@ -7,6 +7,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "crocoddyl/multibody/contacts/multiple-contacts.hpp"
+#include "crocoddyl/core/utils/trace.hpp"
 
 namespace crocoddyl {
 
@@ -52,7 +53,10 @@ void ContactModelMultiple::calc(const boost::shared_ptr<ContactDataMultiple>& da
     boost::shared_ptr<ContactDataAbstract>& d_i = it_d->second;
     assert(it_m->first == it_d->first && "it doesn't match the contact name between data and model");
 
-    m_i.contact->calc(d_i, x);
+    {
+      CROCODDYL_TRACE_SCOPE("contact", it_m->first.c_str(), "calc", -1);
+      m_i.contact->calc(d_i, x);
+    }
     unsigned int const& nc_i = m_i.contact->get_nc();
     data->a0.segment(nc, nc_i) = d_i->a0;
     data->Jc.block(nc, 0, nc_i, nv) = d_i->Jc;
@@ -77,7 +81,10 @@ void ContactModelMultiple::calcDiff(const boost::shared_ptr<ContactDataMultiple>
     boost::shared_ptr<ContactDataAbstract>& d_i = it_d->second;
     assert(it_m->first == it_d->first && "it doesn't match the contact name between data and model");
 
-    m_i.contact->calcDiff(d_i, x, false);
+    {
+      CROCODDYL_TRACE_SCOPE("contact", it_m->first.c_str(), "calcDiff", -1);
+      m_i.contact->calcDiff(d_i, x, false);
+    }
     unsigned int const& nc_i = m_i.contact->get_nc();
     data->Ax.block(nc, 0, nc_i, ndx) = d_i->Ax;
     nc += nc_i;
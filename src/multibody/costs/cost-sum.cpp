@@ -7,6 +7,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "crocoddyl/multibody/costs/cost-sum.hpp"
+#include "crocoddyl/core/utils/trace.hpp"
 
 namespace crocoddyl {
 
@@ -55,7 +56,10 @@ void CostModelSum::calc(const boost::shared_ptr<CostDataSum>& data, const Eigen:
     boost::shared_ptr<CostDataAbstract>& d_i = it_d->second;
     assert(it_m->first == it_d->first && "it doesn't match the cost name between data and model");
 
-    m_i.cost->calc(d_i, x, u);
+    {
+      CROCODDYL_TRACE_SCOPE("cost", it_m->first.c_str(), "calc", -1);
+      m_i.cost->calc(d_i, x, u);
+    }
     data->cost += m_i.weight * d_i->cost;
     if (with_residuals_) {
       unsigned int const& nr_i = m_i.cost->get_activation().get_nr();
@@ -89,7 +93,10 @@ void CostModelSum::calcDiff(const boost::shared_ptr<CostDataSum>& data, const Ei
     boost::shared_ptr<CostDataAbstract>& d_i = it_d->second;
     assert(it_m->first == it_d->first && "it doesn't match the cost name between data and model");
 
-    m_i.cost->calcDiff(d_i, x, u);
+    {
+      CROCODDYL_TRACE_SCOPE("cost", it_m->first.c_str(), "calcDiff", -1);
+      m_i.cost->calcDiff(d_i, x, u);
+    }
     data->Lx += m_i.weight * d_i->Lx;
     data->Lu += m_i.weight * d_i->Lu;
     data->Lxx += m_i.weight * d_i->Lxx;
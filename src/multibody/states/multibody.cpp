@@ -14,14 +14,7 @@ namespace crocoddyl {
 StateMultibody::StateMultibody(pinocchio::Model& model)
     : StateAbstract(model.nq + model.nv, 2 * model.nv),
       pinocchio_(model),
-      x0_(Eigen::VectorXd::Zero(model.nq + model.nv)),
-      dx_(Eigen::VectorXd::Zero(2 * model.nv)),
-      q0_(Eigen::VectorXd::Zero(model.nq)),
-      dq0_(Eigen::VectorXd::Zero(model.nv)),
-      q1_(Eigen::VectorXd::Zero(model.nq)),
-      dq1_(Eigen::VectorXd::Zero(model.nv)),
-      Ji_(Eigen::MatrixXd::Zero(model.nv, model.nv)),
-      Jd_(Eigen::MatrixXd::Zero(model.nv, model.nv)) {
+      x0_(Eigen::VectorXd::Zero(model.nq + model.nv)) {
   x0_.head(nq_) = pinocchio::neutral(pinocchio_);
 }
 
@@ -41,12 +34,8 @@ void StateMultibody::diff(const Eigen::Ref<const Eigen::VectorXd>& x0, const Eig
   assert(x1.size() == nx_ && "x1 has wrong dimension");
   assert(dxout.size() == ndx_ && "Output must be pre-allocated");
 
-  q0_ = x0.head(nq_);
-  q1_ = x1.head(nq_);
-  dq0_ = x0.tail(nv_);
-  dq1_ = x1.tail(nv_);
-  pinocchio::difference(pinocchio_, q0_, q1_, dxout.head(nv_));
-  dxout.tail(nv_) = dq1_ - dq0_;
+  pinocchio::difference(pinocchio_, x0.head(nq_), x1.head(nq_), dxout.head(nv_));
+  dxout.tail(nv_) = x1.tail(nv_) - x0.tail(nv_);
 }
 
 void StateMultibody::integrate(const Eigen::Ref<const Eigen::VectorXd>& x, const Eigen::Ref<const Eigen::VectorXd>& dx,
@@ -55,14 +44,8 @@ void StateMultibody::integrate(const Eigen::Ref<const Eigen::VectorXd>& x, const
   assert(dx.size() == ndx_ && "dx has wrong dimension");
   assert(xout.size() == nx_ && "Output must be pre-allocated");
 
-  q0_ = x.head(nq_);
-  dq0_ = dx.head(nv_);
-  pinocchio::integrate(pinocchio_, q0_, dq0_, q1_);
-  xout.head(nq_) = q1_;
-
-  dq0_ = x.tail(nv_);
-  dq1_ = dx.tail(nv_);
-  xout.tail(nv_) = dq0_ + dq1_;
+  pinocchio::integrate(pinocchio_, x.head(nq_), dx.head(nv_), xout.head(nq_));
+  xout.tail(nv_) = x.tail(nv_) + dx.tail(nv_);
 }
 
 void StateMultibody::Jdiff(const Eigen::Ref<const Eigen::VectorXd>& x0, const Eigen::Ref<const Eigen::VectorXd>& x1,
@@ -72,55 +55,34 @@ void StateMultibody::Jdiff(const Eigen::Ref<const Eigen::VectorXd>& x0, const Ei
   assert(x1.size() == nx_ && "x1 has wrong dimension");
   assert(is_a_Jcomponent(firstsecond) && ("firstsecond must be one of the Jcomponent {both, first, second}"));
 
-  if (firstsecond == first) {
+  // The configuration difference needed by dIntegrate is stored in the bottom-left block of the output Jacobian,
+  // which is zero once the Jacobian is assembled. So we don't need any internal buffer, and the state can be shared
+  // among threads.
+  if (firstsecond == first || firstsecond == both) {
     assert(Jfirst.rows() == ndx_ && Jfirst.cols() == ndx_ && "Jfirst must be of the good size");
 
-    diff(x1, x0, dx_);
-    q1_ = x1.head(nq_);
-    dq1_ = dx_.head(nv_);
-    pinocchio::dIntegrate(pinocchio_, q1_, dq1_, Ji_, pinocchio::ARG1);
-    updateJdiff(Ji_, false);
-
-    Jfirst.setZero();
-    Jfirst.topLeftCorner(nv_, nv_) = Jd_;
-    Jfirst.bottomRightCorner(nv_, nv_).diagonal() = -Eigen::VectorXd::Ones(nv_);
-  } else if (firstsecond == second) {
-    assert(Jsecond.rows() == ndx_ && Jsecond.cols() == ndx_ && "Jsecond must be of the good size");
-
-    diff(x0, x1, dx_);
-    q0_ = x0.head(nq_);
-    dq0_ = dx_.head(nv_);
-    pinocchio::dIntegrate(pinocchio_, q0_, dq0_, Ji_, pinocchio::ARG1);
-    updateJdiff(Ji_);
+    pinocchio::difference(pinocchio_, x1.head(nq_), x0.head(nq_), Jfirst.col(0).tail(nv_));
+    pinocchio::dIntegrate(pinocchio_, x1.head(nq_), Jfirst.col(0).tail(nv_), Jfirst.topLeftCorner(nv_, nv_),
+                          pinocchio::ARG1);
+    updateJdiff(Jfirst.topLeftCorner(nv_, nv_), false);
 
-    Jsecond.setZero();
-    Jsecond.topLeftCorner(nv_, nv_) = Jd_;
-    Jsecond.bottomRightCorner(nv_, nv_).diagonal() = Eigen::VectorXd::Ones(nv_);
-  } else {  // computing both
-    assert(Jfirst.rows() == ndx_ && Jfirst.cols() == ndx_ && "Jfirst must be of the good size");
+    Jfirst.topRightCorner(nv_, nv_).setZero();
+    Jfirst.bottomLeftCorner(nv_, nv_).setZero();
+    Jfirst.bottomRightCorner(nv_, nv_).setZero();
+    Jfirst.bottomRightCorner(nv_, nv_).diagonal().setConstant(-1.);
+  }
+  if (firstsecond == second || firstsecond == both) {
     assert(Jsecond.rows() == ndx_ && Jsecond.cols() == ndx_ && "Jsecond must be of the good size");
 
-    // Computing Jfirst
-    diff(x1, x0, dx_);
-    q1_ = x1.head(nq_);
-    dq1_ = dx_.head(nv_);
-    pinocchio::dIntegrate(pinocchio_, q1_, dq1_, Ji_, pinocchio::ARG1);
-    updateJdiff(Ji_, false);
-
-    Jfirst.setZero();
-    Jfirst.topLeftCorner(nv_, nv_) = Jd_;
-    Jfirst.bottomRightCorner(nv_, nv_).diagonal() = -Eigen::VectorXd::Ones(nv_);
+    pinocchio::difference(pinocchio_, x0.head(nq_), x1.head(nq_), Jsecond.col(0).tail(nv_));
+    pinocchio::dIntegrate(pinocchio_, x0.head(nq_), Jsecond.col(0).tail(nv_), Jsecond.topLeftCorner(nv_, nv_),
+                          pinocchio::ARG1);
+    updateJdiff(Jsecond.topLeftCorner(nv_, nv_));
 
-    // Computing Jsecond
-    diff(x0, x1, dx_);
-    q0_ = x0.head(nq_);
-    dq0_ = dx_.head(nv_);
-    pinocchio::dIntegrate(pinocchio_, q0_, dq0_, Ji_, pinocchio::ARG1);
-    updateJdiff(Ji_);
-
-    Jsecond.setZero();
-    Jsecond.topLeftCorner(nv_, nv_) = Jd_;
-    Jsecond.bottomRightCorner(nv_, nv_).diagonal() = Eigen::VectorXd::Ones(nv_);
+    Jsecond.topRightCorner(nv_, nv_).setZero();
+    Jsecond.bottomLeftCorner(nv_, nv_).setZero();
+    Jsecond.bottomRightCorner(nv_, nv_).setZero();
+    Jsecond.bottomRightCorner(nv_, nv_).diagonal().setConstant(1.);
   }
 }
 
@@ -132,49 +94,32 @@ void StateMultibody::Jintegrate(const Eigen::Ref<const Eigen::VectorXd>& x,
   assert((firstsecond == first || firstsecond == second || firstsecond == both) &&
          ("firstsecond must be one of the Jcomponent {both, first, second}"));
 
-  q0_ = x.head(nq_);
-  dq0_ = dx.head(nv_);
-  if (firstsecond == first) {
+  if (firstsecond == first || firstsecond == both) {
     assert(Jfirst.rows() == ndx_ && Jfirst.cols() == ndx_ && "Jfirst must be of the good size");
 
-    pinocchio::dIntegrate(pinocchio_, q0_, dq0_, Ji_, pinocchio::ARG0);
     Jfirst.setZero();
-    Jfirst.topLeftCorner(nv_, nv_) = Ji_;
-    Jfirst.bottomRightCorner(nv_, nv_).diagonal() = Eigen::VectorXd::Ones(nv_);
-  } else if (firstsecond == second) {
-    assert(Jsecond.rows() == ndx_ && Jsecond.cols() == ndx_ && "Jsecond must be of the good size");
-
-    pinocchio::dIntegrate(pinocchio_, q0_, dq0_, Ji_, pinocchio::ARG1);
-    Jsecond.setZero();
-    Jsecond.topLeftCorner(nv_, nv_) = Ji_;
-    Jsecond.bottomRightCorner(nv_, nv_).diagonal() = Eigen::VectorXd::Ones(nv_);
-  } else {  // computing both
-    assert(Jfirst.rows() == ndx_ && Jfirst.cols() == ndx_ && "Jfirst must be of the good size");
+    pinocchio::dIntegrate(pinocchio_, x.head(nq_), dx.head(nv_), Jfirst.topLeftCorner(nv_, nv_), pinocchio::ARG0);
+    Jfirst.bottomRightCorner(nv_, nv_).diagonal().setConstant(1.);
+  }
+  if (firstsecond == second || firstsecond == both) {
     assert(Jsecond.rows() == ndx_ && Jsecond.cols() == ndx_ && "Jsecond must be of the good size");
 
-    // Computing Jfirst
-    pinocchio::dIntegrate(pinocchio_, q0_, dq0_, Ji_, pinocchio::ARG0);
-    Jfirst.setZero();
-    Jfirst.topLeftCorner(nv_, nv_) = Ji_;
-    Jfirst.bottomRightCorner(nv_, nv_).diagonal() = Eigen::VectorXd::Ones(nv_);
-
-    // Computing Jsecond
-    pinocchio::dIntegrate(pinocchio_, q0_, dq0_, Ji_, pinocchio::ARG1);
     Jsecond.setZero();
-    Jsecond.topLeftCorner(nv_, nv_) = Ji_;
-    Jsecond.bottomRightCorner(nv_, nv_).diagonal() = Eigen::VectorXd::Ones(nv_);
+    pinocchio::dIntegrate(pinocchio_, x.head(nq_), dx.head(nv_), Jsecond.topLeftCorner(nv_, nv_), pinocchio::ARG1);
+    Jsecond.bottomRightCorner(nv_, nv_).diagonal().setConstant(1.);
   }
 }
 
 pinocchio::Model& StateMultibody::get_pinocchio() const { return pinocchio_; }
 
-void StateMultibody::updateJdiff(const Eigen::Ref<const Eigen::MatrixXd>& Jdq, bool positive) {
-  if (positive) {
-    Jd_.diagonal() = Jdq.diagonal();
-    Jd_.block<6, 6>(0, 0) = Jdq.block<6, 6>(0, 0).inverse();
-  } else {
-    Jd_.diagonal() = -Jdq.diagonal();
-    Jd_.block<6, 6>(0, 0) = -Jdq.block<6, 6>(0, 0).inverse();
+void StateMultibody::updateJdiff(Eigen::Ref<Eigen::MatrixXd> Jdq, bool positive) const {
+  // Jdq is overwritten by the inverse of the dIntegrate Jacobian, i.e. its diagonal except for the base block
+  const Eigen::Matrix<double, 6, 6> Jbase = Jdq.block<6, 6>(0, 0).inverse();
+  Jdq.triangularView<Eigen::StrictlyUpper>().setZero();
+  Jdq.triangularView<Eigen::StrictlyLower>().setZero();
+  Jdq.block<6, 6>(0, 0) = Jbase;
+  if (!positive) {
+    Jdq *= -1.;
   }
 }
 
@@ -1,4 +1,7 @@
+import json
+import os
 import sys
+import tempfile
 import unittest
 from random import randint
 
@@ -50,12 +53,78 @@ class ShootingProblemTestCase(unittest.TestCase):
             self.assertTrue(np.allclose(d1.Fx, d2.Fx, atol=1e-9), "Fx doesn't match.")
             self.assertTrue(np.allclose(d1.Fu, d2.Fu, atol=1e-9), "Fu doesn't match.")
 
+    def test_calcDiff_without_recalc(self):
+        # Running calcDiff after calc has to give the same derivatives than recalculating them
+        cost = self.PROBLEM.calcDiff(self.xs, self.us)
+        Fx = [d.Fx.copy() for d in self.PROBLEM.runningDatas]
+        Lx = [d.Lx.copy() for d in self.PROBLEM.runningDatas]
+        self.PROBLEM_DER.calc(self.xs, self.us)
+        self.assertAlmostEqual(cost, self.PROBLEM_DER.calcDiff(self.xs, self.us, False), 10, "Wrong cost value")
+        for d, fx, lx in zip(self.PROBLEM_DER.runningDatas, Fx, Lx):
+            self.assertTrue(np.allclose(d.Fx, fx, atol=1e-9), "Fx doesn't match.")
+            self.assertTrue(np.allclose(d.Lx, lx, atol=1e-9), "Lx doesn't match.")
+
+    def test_multithreading(self):
+        # Running calc and calcDiff with a single thread
+        cost = self.PROBLEM.calcDiff(self.xs, self.us)
+        Fx = [d.Fx.copy() for d in self.PROBLEM.runningDatas]
+        Lx = [d.Lx.copy() for d in self.PROBLEM.runningDatas]
+        # Running them with a few threads should give the same values (including the cost reduction)
+        self.PROBLEM.nthreads = 4
+        self.assertEqual(cost, self.PROBLEM.calc(self.xs, self.us), "Wrong cost value with multiple threads")
+        self.assertEqual(cost, self.PROBLEM.calcDiff(self.xs, self.us), "Wrong cost value with multiple threads")
+        for d, fx, lx in zip(self.PROBLEM.runningDatas, Fx, Lx):
+            self.assertTrue(np.array_equal(d.Fx, fx), "Fx doesn't match with multiple threads.")
+            self.assertTrue(np.array_equal(d.Lx, lx), "Lx doesn't match with multiple threads.")
+
+    def test_x0(self):
+        x0 = self.MODEL.state.rand()
+        self.PROBLEM.x0 = x0
+        self.assertTrue(np.array_equal(self.PROBLEM.x0, x0), "Wrong initial state")
+
+    def test_circular_append(self):
+        # Recycling the first node as last node rotates the nodes
+        self.PROBLEM.calc(self.xs, self.us)
+        xnexts = [d.xnext.copy() for d in self.PROBLEM.runningDatas]
+        self.PROBLEM.circularAppend(self.PROBLEM.runningModels[0], self.PROBLEM.runningDatas[0])
+        self.assertEqual(self.T, self.PROBLEM.T, "Wrong number of nodes")
+        for d, xnext in zip(self.PROBLEM.runningDatas, xnexts[1:] + xnexts[:1]):
+            self.assertTrue(np.array_equal(d.xnext, xnext), "Datas aren't rotated.")
+
+    def test_relinearization(self):
+        # The derivatives are reused until the nodes move beyond the tolerance or are invalidated
+        self.assertTrue(np.isnan(self.PROBLEM.relinearizationTolerance), "Derivatives are reused by default.")
+        self.PROBLEM.relinearizationTolerance = 1e-6
+        cost = self.PROBLEM.calcDiff(self.xs, self.us)
+        self.assertEqual(self.PROBLEM.nreused, 0, "Wrong number of reused nodes.")
+        self.assertEqual(cost, self.PROBLEM.calcDiff(self.xs, self.us), "Wrong cost value")
+        self.assertEqual(self.PROBLEM.nreused, self.T + 1, "Wrong number of reused nodes.")
+        self.PROBLEM.invalidateLinearization(0)
+        self.PROBLEM.calcDiff(self.xs, self.us)
+        self.assertEqual(self.PROBLEM.nreused, self.T, "Wrong number of reused nodes.")
+        self.PROBLEM.invalidateLinearizations()
+        self.PROBLEM.calcDiff(self.xs, self.us)
+        self.assertEqual(self.PROBLEM.nreused, 0, "Wrong number of reused nodes.")
+
     def test_rollout(self):
         xs = self.PROBLEM.rollout(self.us)
         xsDer = self.PROBLEM_DER.rollout(self.us)
         for x1, x2 in zip(xs, xsDer):
             self.assertTrue(np.allclose(x1, x2, atol=1e-9), "The rollout state doesn't match.")
 
+    def test_trace(self):
+        # The nodes are only traced when the library is built with BUILD_WITH_TRACE
+        recorder = crocoddyl.getTraceRecorder()
+        recorder.clear()
+        self.PROBLEM.calc(self.xs, self.us)
+        self.assertIn(recorder.size, [0, self.T + 1], "Wrong number of traced nodes.")
+        filename = os.path.join(tempfile.mkdtemp(), 'trace.json')
+        recorder.dump(filename)
+        with open(filename) as f:
+            events = json.load(f)['traceEvents']
+        self.assertEqual(len(events), recorder.size, "Wrong number of dumped events.")
+        self.assertEqual(sorted(e['args']['node'] for e in events), list(range(len(events))), "Wrong traced nodes.")
+
 
 class UnicycleShootingTest(ShootingProblemTestCase):
     MODEL = crocoddyl.ActionModelUnicycle()
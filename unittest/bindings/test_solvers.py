@@ -6,7 +6,7 @@ import numpy as np
 
 import crocoddyl
 import pinocchio
-from crocoddyl.utils import DDPDerived
+from crocoddyl.utils import DDPDerived, FDDPDerived
 
 
 class SolverAbstractTestCase(unittest.TestCase):
@@ -45,6 +45,79 @@ class SolverAbstractTestCase(unittest.TestCase):
         for k1, k2 in zip(self.solver.k, self.solver_der.k):
             self.assertTrue(np.allclose(k1, k2, atol=1e-9), "k doesn't match.")
 
+    def test_solve_with_parallel_line_search(self):
+        # The parallel line search has to accept the same step lengths than the sequential one
+        problem = crocoddyl.ShootingProblem(self.xs[0], [self.MODEL] * self.T, self.MODEL)
+        solver = self.SOLVER(problem)
+        solver.nthreadsLineSearch = 4
+        self.solver.solve(self.xs, self.us, 10)
+        solver.solve(self.xs, self.us, 10)
+        self.assertEqual(self.solver.iter, solver.iter, "iter doesn't match.")
+        for x1, x2 in zip(self.solver.xs, solver.xs):
+            self.assertTrue(np.allclose(x1, x2, atol=1e-9), "xs doesn't match.")
+        for u1, u2 in zip(self.solver.us, solver.us):
+            self.assertTrue(np.allclose(u1, u2, atol=1e-9), "us doesn't match.")
+
+    def test_solve_with_cost_lower_bound(self):
+        # The costs are non-negative, so stopping the rejected rollouts has to accept the same step lengths
+        problem = crocoddyl.ShootingProblem(self.xs[0], [self.MODEL] * self.T, self.MODEL)
+        solver = self.SOLVER(problem)
+        solver.costLowerBound = 0.
+        self.solver.solve(self.xs, self.us, 10)
+        solver.solve(self.xs, self.us, 10)
+        self.assertEqual(self.solver.iter, solver.iter, "iter doesn't match.")
+        for u1, u2 in zip(self.solver.us, solver.us):
+            self.assertTrue(np.allclose(u1, u2, atol=1e-9), "us doesn't match.")
+
+    def test_shift_horizon(self):
+        self.solver.solve([], [], 10)
+        xs, us, K = self.solver.xs, self.solver.us, self.solver.K
+        self.solver.shiftHorizon()
+        for x1, x2 in zip(self.solver.xs, xs[1:]):
+            self.assertTrue(np.allclose(x1, x2, atol=1e-9), "xs isn't shifted.")
+        for u1, u2 in zip(self.solver.us[:-1], us[1:]):
+            self.assertTrue(np.allclose(u1, u2, atol=1e-9), "us isn't shifted.")
+        # The new last node is warm-started from the feedback policy of the previous last node
+        u = us[-1] - K[-1] * self.MODEL.state.diff(xs[-2], xs[-1])
+        self.assertTrue(np.allclose(self.solver.us[-1], u, atol=1e-9), "Wrong control of the last node.")
+        data = self.MODEL.createData()
+        self.MODEL.calc(data, self.solver.xs[-2], self.solver.us[-1])
+        self.assertTrue(np.allclose(self.solver.xs[-1], data.xnext, atol=1e-9), "Wrong state of the last node.")
+
+    def test_timings(self):
+        self.solver.solve([], [], 10)
+        timings, iterTimings = self.solver.timings, self.solver.iterTimings
+        self.assertGreater(timings.nbackwardPass, 0, "The backward pass wasn't timed.")
+        self.assertGreaterEqual(timings.nbackwardPass, timings.ncalcDiff + timings.nregularizations,
+                                "Wrong number of backward passes.")
+        self.assertEqual(timings.ntrials, timings.nforwardPass, "Wrong number of line-search trials.")
+        self.assertLessEqual(iterTimings.nbackwardPass, timings.nbackwardPass, "Wrong number of backward passes.")
+        self.assertLessEqual(iterTimings.backwardPass, timings.backwardPass, "Wrong time of the backward pass.")
+
+    def test_history(self):
+        converged = self.solver.solve([], [], 10)
+        history = self.solver.history
+        iters = self.solver.iter + 1 if converged else self.solver.iter
+        self.assertEqual(history.shape, (iters, len(crocoddyl.SolverHistoryField.values)), "Wrong history shape.")
+        self.assertFalse(history.flags.writeable, "The history has to be read-only.")
+        self.assertAlmostEqual(history[-1, crocoddyl.SolverHistoryField.Stop], self.solver.stoppingCriteria(), 10,
+                               "Wrong stopping criteria.")
+        self.assertTrue(np.all(history[:, crocoddyl.SolverHistoryField.BackwardPass] >= 0.), "Wrong timings.")
+
+        # The view keeps the previous history when the capacity is changed
+        values = history.copy()
+        self.solver.historyCapacity = 2
+        self.solver.solve([], [], 10)
+        self.assertTrue(np.array_equal(history, values), "The previous history has to be kept.")
+        self.assertLessEqual(self.solver.history.shape[0], 2, "Wrong history shape.")
+
+    def test_status(self):
+        self.solver.computeDirection()
+        self.assertEqual(self.solver.status, crocoddyl.SolverStatus.Success, "Wrong status of the backward pass.")
+        self.assertEqual(self.solver.failedNode, -1, "Wrong failed node.")
+        status = self.solver.forwardPass(1.)
+        self.assertEqual(status, crocoddyl.SolverStatus.Success, "Wrong status of the forward pass.")
+
     def test_compute_search_direction(self):
         # Compute the direction
         self.solver.computeDirection()
@@ -118,8 +191,128 @@ class ManipulatorDDPTest(SolverAbstractTestCase):
     SOLVER_DER = DDPDerived
 
 
+class UnicycleFDDPTest(SolverAbstractTestCase):
+    MODEL = crocoddyl.ActionModelUnicycle()
+    SOLVER = crocoddyl.SolverFDDP
+    SOLVER_DER = FDDPDerived
+
+
+class ManipulatorFDDPTest(SolverAbstractTestCase):
+    ROBOT_MODEL = pinocchio.buildSampleModelManipulator()
+    STATE = crocoddyl.StateMultibody(ROBOT_MODEL)
+    COST_SUM = crocoddyl.CostModelSum(STATE, ROBOT_MODEL.nv)
+    COST_SUM.addCost('xReg', crocoddyl.CostModelState(STATE), 1e-7)
+    COST_SUM.addCost('uReg', crocoddyl.CostModelControl(STATE), 1e-7)
+    COST_SUM.addCost(
+        'frTrack',
+        crocoddyl.CostModelFramePlacement(
+            STATE, crocoddyl.FramePlacement(ROBOT_MODEL.getFrameId("effector_body"), pinocchio.SE3.Random())), 1.)
+    DIFF_MODEL = crocoddyl.DifferentialActionModelFreeFwdDynamics(STATE, COST_SUM)
+    MODEL = crocoddyl.IntegratedActionModelEuler(crocoddyl.DifferentialActionModelFreeFwdDynamics(STATE, COST_SUM),
+                                                 1e-3)
+    SOLVER = crocoddyl.SolverFDDP
+    SOLVER_DER = FDDPDerived
+
+
+class UnicycleBoxDDPTest(unittest.TestCase):
+    MODEL = crocoddyl.ActionModelUnicycle()
+
+    def setUp(self):
+        self.T = randint(1, 21)
+        state = self.MODEL.state
+        self.x0 = state.rand()
+        self.PROBLEM = crocoddyl.ShootingProblem(self.x0, [self.MODEL] * self.T, self.MODEL)
+        self.PROBLEM_DDP = crocoddyl.ShootingProblem(self.x0, [self.MODEL] * self.T, self.MODEL)
+        self.solver = crocoddyl.SolverBoxDDP(self.PROBLEM)
+        self.solver_ddp = crocoddyl.SolverDDP(self.PROBLEM_DDP)
+
+    def test_solve_without_limits(self):
+        # Without control limits it has to behave as DDP
+        self.solver.solve([], [], 10)
+        self.solver_ddp.solve([], [], 10)
+        for x1, x2 in zip(self.solver.xs, self.solver_ddp.xs):
+            self.assertTrue(np.allclose(x1, x2, atol=1e-9), "xs doesn't match.")
+        for u1, u2 in zip(self.solver.us, self.solver_ddp.us):
+            self.assertTrue(np.allclose(u1, u2, atol=1e-9), "us doesn't match.")
+
+    def test_solve_with_limits(self):
+        ul = -0.1 * np.matrix(np.ones(self.MODEL.nu)).T
+        uu = 0.1 * np.matrix(np.ones(self.MODEL.nu)).T
+        self.solver.ul = ul
+        self.solver.uu = uu
+        self.assertTrue(self.solver.solve([], [], 100), "BoxDDP didn't converge.")
+        for u in self.solver.us:
+            self.assertTrue(np.all(u >= ul - 1e-12) and np.all(u <= uu + 1e-12), "us violates the limits.")
+
+
+class UnicycleKKTTest(unittest.TestCase):
+    MODEL = crocoddyl.ActionModelUnicycle()
+
+    def setUp(self):
+        self.T = randint(1, 21)
+        state = self.MODEL.state
+        self.xs = []
+        self.us = []
+        self.xs.append(state.rand())
+        for i in range(self.T):
+            self.xs.append(state.rand())
+            self.us.append(pinocchio.utils.rand(self.MODEL.nu))
+        self.PROBLEM = crocoddyl.ShootingProblem(self.xs[0], [self.MODEL] * self.T, self.MODEL)
+        self.PROBLEM_DDP = crocoddyl.ShootingProblem(self.xs[0], [self.MODEL] * self.T, self.MODEL)
+        self.solver = crocoddyl.SolverKKT(self.PROBLEM)
+        self.solver_ddp = crocoddyl.SolverDDP(self.PROBLEM_DDP)
+
+    def test_dimension(self):
+        self.assertEqual(self.solver.ndx, (self.T + 1) * self.MODEL.state.ndx, "Wrong ndx.")
+        self.assertEqual(self.solver.nu, self.T * self.MODEL.nu, "Wrong nu.")
+        self.assertEqual(self.solver.kktref.shape[0], 2 * self.solver.ndx + self.solver.nu, "Wrong KKT dimension.")
+
+    def test_compute_search_direction(self):
+        # The KKT step has to follow the DDP policy, i.e. du = -k - K dx
+        self.solver.setCandidate(self.xs, self.us, False)
+        self.solver_ddp.setCandidate(self.xs, self.us, False)
+        self.solver.computeDirection()
+        self.solver_ddp.computeDirection()
+        for dx, du, k, K in zip(self.solver.dxs, self.solver.dus, self.solver_ddp.k, self.solver_ddp.K):
+            self.assertTrue(np.allclose(du, -k - K * dx, atol=1e-7), "Step doesn't match the DDP policy.")
+
+    def test_solve(self):
+        self.assertTrue(self.solver.solve([], [], 10), "KKT didn't converge.")
+        self.solver_ddp.solve([], [], 10)
+        self.assertAlmostEqual(self.PROBLEM.calc(self.solver.xs, self.solver.us),
+                               self.PROBLEM_DDP.calc(self.solver_ddp.xs, self.solver_ddp.us), 7, "Wrong optimal cost.")
+
+
+class UnicycleBatchTest(unittest.TestCase):
+    MODEL = crocoddyl.ActionModelUnicycle()
+
+    def setUp(self):
+        self.T = randint(1, 21)
+        state = self.MODEL.state
+        self.x0s = [state.rand() for i in range(4)]
+        self.PROBLEM = crocoddyl.ShootingProblem(self.x0s[0], [self.MODEL] * self.T, self.MODEL)
+        self.solver = crocoddyl.SolverBatch(self.PROBLEM, 2)
+
+    def test_solve(self):
+        # Each column is the solution of its own initial state
+        self.solver.solve(self.x0s, maxiter=10)
+        self.assertEqual(self.solver.xs.shape, ((self.T + 1) * self.MODEL.state.nx, len(self.x0s)), "Wrong xs shape.")
+        self.assertEqual(self.solver.us.shape, (self.T * self.MODEL.nu, len(self.x0s)), "Wrong us shape.")
+        self.assertGreater(self.solver.throughput, 0., "Wrong throughput.")
+        for i, x0 in enumerate(self.x0s):
+            problem = crocoddyl.ShootingProblem(x0, [self.MODEL] * self.T, self.MODEL)
+            solver = crocoddyl.SolverFDDP(problem)
+            solver.solve([], [], 10)
+            self.assertEqual(self.solver.iters[i], solver.iter, "iter doesn't match.")
+            self.assertAlmostEqual(self.solver.costs[i], problem.calc(solver.xs, solver.us), 7, "cost doesn't match.")
+            self.assertTrue(np.allclose(self.solver.us[:, i], np.vstack(solver.us), atol=1e-9), "us doesn't match.")
+
+
 if __name__ == '__main__':
-    test_classes_to_run = [UnicycleDDPTest, ManipulatorDDPTest]
+    test_classes_to_run = [
+        UnicycleDDPTest, ManipulatorDDPTest, UnicycleFDDPTest, ManipulatorFDDPTest, UnicycleBoxDDPTest,
+        UnicycleKKTTest, UnicycleBatchTest
+    ]
     loader = unittest.TestLoader()
     suites_list = []
     for test_class in test_classes_to_run:
@@ -89,6 +89,24 @@ void test_partial_derivatives_against_numdiff(crocoddyl::ActionModelAbstract& mo
 
 //____________________________________________________________________________//
 
+void test_quasic_static_newton_step(crocoddyl::ActionModelAbstract& model) {
+  boost::shared_ptr<crocoddyl::ActionDataAbstract> data = model.createData();
+  Eigen::VectorXd x = model.get_state().rand();
+  Eigen::VectorXd u = Eigen::VectorXd::Random(model.get_nu());
+
+  // Computing the expected Newton step with the pseudo-inverse of Fu
+  Eigen::VectorXd dx(model.get_state().get_ndx());
+  model.calcDiff(data, x, u);
+  model.get_state().diff(x, data->xnext, dx);
+  Eigen::VectorXd u_expected = u - pseudoInverse(data->Fu) * data->Fx * dx;
+
+  // Checking that a single quasic-static iteration reproduces it
+  model.quasicStatic(data, u, x, 1);
+  BOOST_CHECK((u - u_expected).isMuchSmallerThan(1.0, 1e-9));
+}
+
+//____________________________________________________________________________//
+
 void register_action_model_lqr_unit_tests() {
   int nx = 80;
   int nu = 40;
@@ -103,6 +121,8 @@ void register_action_model_lqr_unit_tests() {
       BOOST_TEST_CASE(boost::bind(&test_calc_returns_a_cost, crocoddyl::ActionModelLQR(nx, nu, driftfree))));
   framework::master_test_suite().add(BOOST_TEST_CASE(boost::bind(
       &test_partial_derivatives_against_numdiff, crocoddyl::ActionModelLQR(nx, nu, driftfree), num_diff_modifier)));
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_quasic_static_newton_step, crocoddyl::ActionModelLQR(nx, nu, driftfree))));
 }
 
 //____________________________________________________________________________//
@@ -0,0 +1,911 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (C) 2018-2019, LAAS-CNRS
+// Copyright note valid unless otherwise stated in individual files.
+// All rights reserved.
+///////////////////////////////////////////////////////////////////////////////
+
+#define BOOST_TEST_NO_MAIN
+#define BOOST_TEST_ALTERNATIVE_INIT_API
+#include <boost/test/included/unit_test.hpp>
+#include <boost/bind.hpp>
+#include <cmath>
+#include <cstddef>
+#include "crocoddyl/core/actions/lqr.hpp"
+#include "crocoddyl/core/actions/unicycle.hpp"
+#include "crocoddyl/core/solvers/ddp.hpp"
+#include "crocoddyl/core/solvers/fddp.hpp"
+#include "crocoddyl/core/solvers/box-ddp.hpp"
+#include "crocoddyl/core/solvers/batch.hpp"
+#include "crocoddyl/core/solvers/kkt.hpp"
+#include "crocoddyl/core/utils/callbacks.hpp"
+#include "crocoddyl/core/utils/policy.hpp"
+#include "crocoddyl/core/utils/solution-publisher.hpp"
+#include "crocoddyl/core/utils/timer.hpp"
+#include <Eigen/Dense>
+
+using namespace boost::unit_test;
+
+// Counting the heap allocations by intercepting the glibc allocator. Eigen and the operator new of libstdc++ end up
+// calling malloc, so this catches any dynamic allocation done by the solver.
+static bool is_counting = false;
+static std::size_t allocations = 0;
+
+#ifdef __GLIBC__
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t n, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+
+void* malloc(std::size_t size) {
+  if (is_counting) ++allocations;
+  return __libc_malloc(size);
+}
+
+void* calloc(std::size_t n, std::size_t size) {
+  if (is_counting) ++allocations;
+  return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, std::size_t size) {
+  if (is_counting) ++allocations;
+  return __libc_realloc(ptr, size);
+}
+}
+#endif
+
+//____________________________________________________________________________//
+
+// The unicycle problem shared by the tests, with a random initial state
+struct UnicycleProblem {
+  explicit UnicycleProblem(const unsigned int& T)
+      : running_models(T, &model), problem(model.get_state().rand(), running_models, &model) {}
+
+  crocoddyl::ActionModelUnicycle model;
+  std::vector<crocoddyl::ActionModelAbstract*> running_models;
+  crocoddyl::ShootingProblem problem;
+};
+
+//____________________________________________________________________________//
+
+template <typename Solver>
+void test_solve_does_not_allocate(const bool& warm_start, const bool& sqrt_riccati) {
+#ifndef __GLIBC__
+  BOOST_TEST_MESSAGE("Skipping the allocation test, the allocator can only be intercepted with glibc");
+  return;
+#endif
+  const unsigned int T = 50;
+  UnicycleProblem unicycle(T);
+  const Eigen::VectorXd x0 = unicycle.problem.get_x0();
+  Solver solver(unicycle.problem);
+  solver.set_sqrt_riccati(sqrt_riccati);
+
+  std::vector<Eigen::VectorXd> xs(T + 1, x0);
+  std::vector<Eigen::VectorXd> us(T, Eigen::VectorXd::Zero(unicycle.model.get_nu()));
+
+  // The OpenMP runtime allocates its thread team in the first parallel region, so we run one before counting
+  unicycle.problem.calcDiff(xs, us);
+
+  allocations = 0;
+  is_counting = true;
+  if (warm_start) {
+    solver.solve(xs, us, 20);
+  } else {
+    solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 20);
+  }
+  is_counting = false;
+
+  BOOST_CHECK(solver.get_iter() > 0);
+  BOOST_CHECK_EQUAL(allocations, 0);
+}
+
+//____________________________________________________________________________//
+
+void test_quasic_static_does_not_allocate() {
+#ifndef __GLIBC__
+  BOOST_TEST_MESSAGE("Skipping the allocation test, the allocator can only be intercepted with glibc");
+  return;
+#endif
+  crocoddyl::ActionModelUnicycle model;
+  boost::shared_ptr<crocoddyl::ActionDataAbstract> data = model.createData();
+  const Eigen::VectorXd x = model.get_state().rand();
+  Eigen::VectorXd u = Eigen::VectorXd::Zero(model.get_nu());
+
+  allocations = 0;
+  is_counting = true;
+  model.quasicStatic(data, u, x, 10);
+  is_counting = false;
+
+  BOOST_CHECK_EQUAL(allocations, 0);
+}
+
+//____________________________________________________________________________//
+
+template <typename Solver>
+void test_timings() {
+  const unsigned int T = 50;
+  UnicycleProblem unicycle(T);
+  Solver solver(unicycle.problem);
+  solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 10);
+
+  const crocoddyl::SolverTimings& timings = solver.get_timings();
+  const crocoddyl::SolverTimings& iter_timings = solver.get_iterTimings();
+  BOOST_CHECK(timings.nbackwardPass > 0);
+  BOOST_CHECK(timings.ncalc > 0 && timings.ncalc <= timings.ncalcDiff);
+  BOOST_CHECK(timings.nbackwardPass >= timings.ncalcDiff + timings.nregularizations);
+  BOOST_CHECK_EQUAL(timings.ntrials, timings.nforwardPass);
+  BOOST_CHECK(timings.calcDiff > 0. && timings.backwardPass > 0. && timings.forwardPass > 0.);
+  BOOST_CHECK(iter_timings.nbackwardPass > 0 && iter_timings.nbackwardPass <= timings.nbackwardPass);
+  BOOST_CHECK(iter_timings.backwardPass <= timings.backwardPass);
+
+  // The timings are restarted by each solve, so a single iteration accounts for all of them
+  solver.solve(solver.get_xs(), solver.get_us(), 1);
+  BOOST_CHECK_EQUAL(timings.nbackwardPass, iter_timings.nbackwardPass);
+}
+
+//____________________________________________________________________________//
+
+void test_riccati_workspace() {
+  const unsigned int T = 20;
+  UnicycleProblem unicycle(T);
+  crocoddyl::SolverDDP solver(unicycle.problem);
+  solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 10);
+
+  // The blocks of the arena start at a cache line, and the getters return copies of them
+  for (unsigned int t = 0; t < T; ++t) {
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::size_t>(solver.get_K_map()[t].data()) % 64, 0);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::size_t>(solver.get_Vxx_map()[t].data()) % 64, 0);
+    BOOST_CHECK(solver.get_K()[t] == solver.get_K_map()[t]);
+    BOOST_CHECK(solver.get_Vxx()[t] == solver.get_Vxx_map()[t]);
+  }
+
+  // Shifting the horizon rotates the workspace of the running nodes
+  const std::vector<Eigen::MatrixXd> K = solver.get_K();
+  const std::vector<Eigen::MatrixXd> Vxx = solver.get_Vxx();
+  solver.shiftHorizon();
+  for (unsigned int t = 0; t + 1 < T; ++t) {
+    BOOST_CHECK((solver.get_K()[t] - K[t + 1]).isZero(0.));
+    BOOST_CHECK((solver.get_Vxx()[t] - Vxx[t + 1]).isZero(0.));
+  }
+  BOOST_CHECK((solver.get_Vxx()[T] - Vxx[T]).isZero(0.));
+}
+
+//____________________________________________________________________________//
+
+template <typename Solver>
+void test_backward_pass_is_symmetric() {
+  const unsigned int T = 20;
+  UnicycleProblem unicycle(T);
+  Solver solver(unicycle.problem);
+  solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 1);
+
+  for (unsigned int t = 0; t < T; ++t) {
+    BOOST_CHECK((solver.get_Vxx()[t] - solver.get_Vxx()[t].transpose()).isZero(0.));
+    BOOST_CHECK((solver.get_Qxx()[t] - solver.get_Qxx()[t].transpose()).isZero(0.));
+    BOOST_CHECK((solver.get_Quu()[t] - solver.get_Quu()[t].transpose()).isZero(0.));
+    // The value function is Qxx - Qxu * Quu^-1 * Qux, with the (regularized) Quu used by the gains
+    const Eigen::MatrixXd Vxx = solver.get_Qxx()[t] - solver.get_Qxu()[t] * solver.get_K()[t];
+    BOOST_CHECK(solver.get_Vxx()[t].isApprox(Vxx, 1e-9));
+  }
+}
+
+//____________________________________________________________________________//
+
+template <typename Solver>
+void test_sqrt_riccati() {
+  const unsigned int T = 50;
+  UnicycleProblem unicycle(T);
+  Solver solver(unicycle.problem);
+  Solver sqrt_solver(unicycle.problem);
+  sqrt_solver.set_sqrt_riccati(true);
+
+  // Both recursions compute the same Riccati gains and value functions up to round-off
+  solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 1);
+  sqrt_solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 1);
+  for (unsigned int t = 0; t < T; ++t) {
+    BOOST_CHECK(sqrt_solver.get_K()[t].isApprox(solver.get_K()[t], 1e-9));
+    BOOST_CHECK(sqrt_solver.get_k()[t].isApprox(solver.get_k()[t], 1e-9));
+    BOOST_CHECK(sqrt_solver.get_Vxx()[t].isApprox(solver.get_Vxx()[t], 1e-9));
+    BOOST_CHECK(sqrt_solver.get_Vx()[t].isApprox(solver.get_Vx()[t], 1e-9));
+  }
+
+  // The round-off errors may change the number of iterations, but not the solution (up to the stopping tolerance)
+  BOOST_CHECK(solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 200));
+  BOOST_CHECK(sqrt_solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 200));
+  BOOST_CHECK(std::abs(solver.get_cost() - sqrt_solver.get_cost()) < 1e-9 * (1. + std::abs(solver.get_cost())));
+  for (unsigned int t = 0; t < T; ++t) {
+    BOOST_CHECK((sqrt_solver.get_us()[t] - solver.get_us()[t]).isMuchSmallerThan(1.0, 1e-5));
+  }
+}
+
+//____________________________________________________________________________//
+
+template <typename Solver>
+void test_partitioned_riccati(const bool& sqrt_riccati) {
+  const unsigned int T = 60;
+  UnicycleProblem unicycle(T);
+  std::vector<Eigen::VectorXd> xs(T + 1);
+  std::vector<Eigen::VectorXd> us(T, Eigen::VectorXd::Random(unicycle.model.get_nu()));
+  for (unsigned int t = 0; t <= T; ++t) {
+    xs[t] = unicycle.model.get_state().rand();
+  }
+  Solver solver(unicycle.problem);
+  solver.set_sqrt_riccati(sqrt_riccati);
+  Solver partitioned(unicycle.problem);
+  partitioned.set_sqrt_riccati(sqrt_riccati);
+  partitioned.set_nthreads_riccati(4);
+
+  // The gains of the first iteration, which start from an infeasible guess (i.e. with gaps)
+  solver.solve(xs, us, 1);
+  partitioned.solve(xs, us, 1);
+  for (unsigned int t = 0; t < T; ++t) {
+    BOOST_CHECK(partitioned.get_K()[t].isApprox(solver.get_K()[t], 1e-8));
+    BOOST_CHECK(partitioned.get_k()[t].isApprox(solver.get_k()[t], 1e-8));
+    BOOST_CHECK(partitioned.get_Vxx()[t].isApprox(solver.get_Vxx()[t], 1e-8));
+    BOOST_CHECK(partitioned.get_Vx()[t].isApprox(solver.get_Vx()[t], 1e-8));
+  }
+
+  solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 100);
+  partitioned.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 100);
+  BOOST_CHECK_EQUAL(solver.get_iter(), partitioned.get_iter());
+  BOOST_CHECK(std::abs(solver.get_cost() - partitioned.get_cost()) < 1e-9 * (1. + std::abs(solver.get_cost())));
+}
+
+//____________________________________________________________________________//
+
+template <typename Solver>
+void test_failed_node() {
+  const unsigned int T = 20;
+  const int node = 7;
+  crocoddyl::ActionModelUnicycle model;
+  crocoddyl::ActionModelUnicycle nan_model;
+  nan_model.set_cost_weights(Eigen::Vector2d::Constant(NAN));
+  std::vector<crocoddyl::ActionModelAbstract*> running_models(T, &model);
+  running_models[node] = &nan_model;
+  crocoddyl::ShootingProblem problem(model.get_state().rand(), running_models, &model);
+  Solver solver(problem);
+
+  // The backward pass fails at the node whose derivatives aren't finite, even after regularizing it
+  BOOST_CHECK(!solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 10));
+  BOOST_CHECK_EQUAL(solver.get_status(), crocoddyl::SolverStatusBackwardError);
+  BOOST_CHECK_EQUAL(solver.get_failedNode(), node);
+  BOOST_CHECK(solver.get_timings().nregularizations > 0);
+
+  // The rollout diverges at the node whose cost isn't finite
+  BOOST_CHECK_EQUAL(solver.forwardPass(1.), crocoddyl::SolverStatusForwardError);
+  BOOST_CHECK_EQUAL(solver.get_failedNode(), node);
+}
+
+//____________________________________________________________________________//
+
+template <typename Solver>
+void test_non_convex_node() {
+  const unsigned int T = 20;
+  const int node = 7;
+  crocoddyl::ActionModelLQR model(4, 2);
+  crocoddyl::ActionModelLQR concave_model(4, 2);
+  concave_model.Luu_ *= -1e12;
+  std::vector<crocoddyl::ActionModelAbstract*> running_models(T, &model);
+  running_models[node] = &concave_model;
+  crocoddyl::ShootingProblem problem(Eigen::VectorXd::Ones(4), running_models, &model);
+  Solver solver(problem);
+
+  // The backward pass fails at the node whose Quu isn't positive definite, even with the largest regularization
+  BOOST_CHECK(!solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 10));
+  BOOST_CHECK_EQUAL(solver.get_status(), crocoddyl::SolverStatusBackwardError);
+  BOOST_CHECK_EQUAL(solver.get_failedNode(), node);
+}
+
+//____________________________________________________________________________//
+
+template <typename Solver>
+void test_mixed_state_dimensions() {
+  const unsigned int T = 10;
+  crocoddyl::ActionModelLQR model(4, 2);
+  // The last running node projects the state onto the 3-dimensional terminal state
+  crocoddyl::ActionModelLQR projection_model(4, 2);
+  projection_model.Fx_ = Eigen::MatrixXd::Identity(3, 4);
+  projection_model.Fu_ = Eigen::MatrixXd::Identity(3, 2);
+  crocoddyl::ActionModelLQR terminal_model(3, 2);
+  std::vector<crocoddyl::ActionModelAbstract*> running_models(T, &model);
+  running_models.back() = &projection_model;
+  crocoddyl::ShootingProblem problem(Eigen::VectorXd::Ones(4), running_models, &terminal_model);
+
+  // The same problem with a 4-dimensional terminal state, whose last component is zero and doesn't have a cost
+  crocoddyl::ActionModelLQR padded_projection_model(4, 2);
+  padded_projection_model.Fx_.bottomRightCorner(1, 1).setZero();
+  crocoddyl::ActionModelLQR padded_terminal_model(4, 2);
+  padded_terminal_model.Lxx_.bottomRightCorner(1, 1).setZero();
+  padded_terminal_model.lx_.tail(1).setZero();
+  std::vector<crocoddyl::ActionModelAbstract*> padded_running_models(T, &model);
+  padded_running_models.back() = &padded_projection_model;
+  crocoddyl::ShootingProblem padded_problem(Eigen::VectorXd::Ones(4), padded_running_models, &padded_terminal_model);
+  Solver padded_solver(padded_problem);
+  BOOST_CHECK(padded_solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 20));
+
+  // Both variants of the backward pass handle a next node of a different dimension
+  for (int sqrt_riccati = 0; sqrt_riccati < 2; ++sqrt_riccati) {
+    Solver solver(problem);
+    solver.set_sqrt_riccati(sqrt_riccati == 1);
+    BOOST_CHECK(solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 20));
+    BOOST_CHECK_EQUAL(solver.get_Vxx()[T].rows(), 3);
+    BOOST_CHECK_EQUAL(solver.get_K()[T - 1].cols(), 4);
+    BOOST_CHECK(std::abs(solver.get_cost() - padded_solver.get_cost()) <= 1e-9 * std::abs(padded_solver.get_cost()));
+    for (unsigned int t = 0; t < T; ++t) {
+      BOOST_CHECK((solver.get_us()[t] - padded_solver.get_us()[t]).isZero(1e-9));
+    }
+  }
+}
+
+//____________________________________________________________________________//
+
+template <typename Solver>
+void test_cost_lower_bound() {
+  const unsigned int T = 50;
+  UnicycleProblem unicycle(T);
+  std::vector<Eigen::VectorXd> xs(T + 1);
+  std::vector<Eigen::VectorXd> us(T);
+  for (unsigned int t = 0; t < T; ++t) {
+    xs[t] = unicycle.model.get_state().rand();
+    us[t] = Eigen::VectorXd::Random(unicycle.model.get_nu());
+  }
+  xs.back() = unicycle.model.get_state().rand();
+
+  // The unicycle's costs are non-negative, so stopping the rejected rollouts doesn't change the accepted steps
+  Solver solver(unicycle.problem);
+  solver.solve(xs, us, 50);
+  Solver bounded_solver(unicycle.problem);
+  bounded_solver.set_cost_lower_bound(0.);
+  bounded_solver.solve(xs, us, 50);
+  BOOST_CHECK_EQUAL(solver.get_iter(), bounded_solver.get_iter());
+  BOOST_CHECK_EQUAL(solver.get_cost(), bounded_solver.get_cost());
+  for (unsigned int t = 0; t < T; ++t) {
+    BOOST_CHECK((solver.get_us()[t] - bounded_solver.get_us()[t]).isZero(0.));
+  }
+
+  // A rollout that cannot reach a negative cost is stopped at the first node
+  BOOST_CHECK_EQUAL(bounded_solver.forwardPass(1., -1.), crocoddyl::SolverStatusStepRejected);
+  BOOST_CHECK_EQUAL(bounded_solver.get_failedNode(), 0);
+}
+
+//____________________________________________________________________________//
+
+template <typename Solver>
+void test_time_budget() {
+  const unsigned int T = 50;
+  UnicycleProblem unicycle(T);
+  Solver solver(unicycle.problem);
+  solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 100);
+  BOOST_CHECK(!solver.get_stoppedByBudget());
+
+  // An exhausted budget stops the solve after the first search direction, and it keeps the candidate
+  std::vector<Eigen::VectorXd> us(T, Eigen::VectorXd::Ones(unicycle.model.get_nu()));
+  solver.set_time_budget(0.);
+  BOOST_CHECK(!solver.solve(crocoddyl::DEFAULT_VECTOR, us, 100));
+  BOOST_CHECK(solver.get_stoppedByBudget());
+  BOOST_CHECK_EQUAL(solver.get_iter(), 0);
+  BOOST_CHECK_EQUAL(solver.get_timings().nbackwardPass, 1);
+  for (unsigned int t = 0; t < T; ++t) {
+    BOOST_CHECK((solver.get_us()[t] - us[t]).isZero(0.));
+  }
+}
+
+//____________________________________________________________________________//
+
+template <typename Solver>
+void test_time_budget_keeps_gains() {
+  const unsigned int T = 50;
+  UnicycleProblem unicycle(T);
+  std::vector<Eigen::VectorXd> xs(T + 1, unicycle.problem.get_x0());
+  std::vector<Eigen::VectorXd> us(T, Eigen::VectorXd::Ones(unicycle.model.get_nu()));
+  Solver solver(unicycle.problem);
+  crocoddyl::Timer timer;
+  solver.solve(xs, us, 100);
+  const double duration = timer.get_duration();
+
+  // Whenever the budget stops the solve, the gains are the ones of a fresh search direction of the candidate
+  for (unsigned int i = 1; i < 10; ++i) {
+    solver.set_time_budget(0.1 * i * duration);
+    solver.solve(xs, us, 100);
+    if (!solver.get_stoppedByBudget()) {
+      continue;
+    }
+    const std::vector<Eigen::MatrixXd> K = solver.get_K();
+    const std::vector<Eigen::VectorXd> k = solver.get_k();
+    solver.computeDirection(true);
+    for (unsigned int t = 0; t < T; ++t) {
+      BOOST_CHECK((K[t] - solver.get_K()[t]).isZero(1e-9));
+      BOOST_CHECK((k[t] - solver.get_k()[t]).isZero(1e-9));
+    }
+  }
+}
+
+//____________________________________________________________________________//
+
+void test_box_qp_round_off() {
+  // An ill-conditioned QP whose gradient at the solution is above the tolerance due to the round-off errors
+  Eigen::MatrixXd R(3, 3);
+  R << 1., 2., 0., -1., 1., 1., 0.5, 0., 1.;
+  const Eigen::Vector3d e(1e3, 1., 1e-6);
+  const Eigen::MatrixXd H = R * e.asDiagonal() * R.transpose();
+  const Eigen::Vector3d q(1e8, -3e8, 2e5);
+  const Eigen::VectorXd lb = Eigen::VectorXd::Constant(3, -1e15);
+  const Eigen::VectorXd ub = Eigen::VectorXd::Constant(3, 1e15);
+
+  // The cost cannot decrease further, so the solution is the last iterate instead of a failure
+  crocoddyl::BoxQP qp(3);
+  BOOST_CHECK(qp.solve(H, q, lb, ub, Eigen::VectorXd::Zero(3)));
+  const Eigen::VectorXd x = H.llt().solve(-q);
+  BOOST_CHECK((qp.get_x() - x).norm() <= 1e-6 * x.norm());
+}
+
+//____________________________________________________________________________//
+
+void test_kkt_non_convex() {
+  const unsigned int T = 20;
+  crocoddyl::ActionModelLQR model(4, 2);
+  crocoddyl::ActionModelLQR concave_model(4, 2);
+  concave_model.Luu_ *= -100.;
+  std::vector<crocoddyl::ActionModelAbstract*> running_models(T, &model);
+  running_models.back() = &concave_model;
+  crocoddyl::ShootingProblem problem(Eigen::VectorXd::Ones(4), running_models, &model);
+  std::vector<Eigen::VectorXd> xs(T + 1, Eigen::VectorXd::Zero(4));
+  std::vector<Eigen::VectorXd> us(T, Eigen::VectorXd::Zero(2));
+  us.back().setOnes();
+  problem.rollout(us, xs);
+  const double cost = problem.calc(xs, us);
+
+  // The Newton step goes to a saddle point with a higher cost, so it is rejected and the Hessian is regularized
+  // until the step is a descent direction
+  crocoddyl::SolverKKT solver(problem);
+  solver.solve(xs, us, 20, true);
+  BOOST_CHECK(solver.get_xreg() > 1e-9);
+  BOOST_CHECK(solver.get_cost() < cost);
+}
+
+//____________________________________________________________________________//
+
+template <typename Solver>
+void test_parallel_line_search() {
+  const unsigned int T = 50;
+  crocoddyl::ActionModelUnicycle model;
+  std::vector<crocoddyl::ActionModelAbstract*> running_models(T, &model);
+  // Far from the goal, the accepted step lengths belong to several batches of the parallel line search
+  const Eigen::Vector3d x0(-80., 60., 2.);
+  std::vector<Eigen::VectorXd> xs(T + 1, x0);
+  std::vector<Eigen::VectorXd> us(T, Eigen::VectorXd::Constant(model.get_nu(), 10.));
+  crocoddyl::ShootingProblem serial_problem(x0, running_models, &model);
+  Solver serial(serial_problem);
+  const bool is_solved = serial.solve(xs, us, 100);
+  const Eigen::VectorXd steplengths = serial.get_history().col(crocoddyl::SolverHistoryStepLength);
+  const Eigen::VectorXd costs = serial.get_history().col(crocoddyl::SolverHistoryCost);
+  BOOST_CHECK(steplengths.minCoeff() < 0.25);
+
+  const unsigned int nthreads[] = {2, 4};
+  for (unsigned int i = 0; i < sizeof(nthreads) / sizeof(nthreads[0]); ++i) {
+    // Each solver has its own problem, as the parallel line search swaps the datas of the problem
+    crocoddyl::ShootingProblem problem(x0, running_models, &model);
+    Solver solver(problem);
+    solver.set_nthreads_linesearch(nthreads[i]);
+    BOOST_CHECK_EQUAL(solver.solve(xs, us, 100), is_solved);
+    BOOST_CHECK_EQUAL(solver.get_iter(), serial.get_iter());
+    BOOST_CHECK(solver.get_history().col(crocoddyl::SolverHistoryStepLength) == steplengths);
+    BOOST_CHECK(solver.get_history().col(crocoddyl::SolverHistoryCost) == costs);
+    for (unsigned int t = 0; t < T; ++t) {
+      BOOST_CHECK(solver.get_xs()[t] == serial.get_xs()[t]);
+      BOOST_CHECK(solver.get_us()[t] == serial.get_us()[t]);
+    }
+    BOOST_CHECK(solver.get_xs().back() == serial.get_xs().back());
+
+    // The swapped datas are the ones of the candidate, so evaluating the problem again doesn't change its cost
+    BOOST_CHECK_EQUAL(problem.calc(solver.get_xs(), solver.get_us()), solver.get_cost());
+  }
+}
+
+//____________________________________________________________________________//
+
+void test_lazy_relinearization() {
+  const unsigned int T = 20;
+  UnicycleProblem unicycle(T);
+  const Eigen::VectorXd x = unicycle.problem.get_x0();
+  std::vector<Eigen::VectorXd> xs(T + 1, x);
+  std::vector<Eigen::VectorXd> us(T, Eigen::VectorXd::Ones(unicycle.model.get_nu()));
+
+  // The derivatives are always evaluated by default
+  unicycle.problem.calcDiff(xs, us);
+  unicycle.problem.calcDiff(xs, us);
+  BOOST_CHECK_EQUAL(unicycle.problem.get_nreused(), 0);
+
+  unicycle.problem.set_relinearization_tolerance(1e-6);
+  const double cost = unicycle.problem.calcDiff(xs, us);
+  BOOST_CHECK_EQUAL(unicycle.problem.get_nreused(), 0);
+  BOOST_CHECK_EQUAL(unicycle.problem.calcDiff(xs, us), cost);
+  BOOST_CHECK_EQUAL(unicycle.problem.get_nreused(), T + 1);
+
+  // A node is evaluated if it moved beyond the tolerance, or if it was invalidated
+  xs[3][0] += 1e-9;
+  us[4][0] += 1e-3;
+  unicycle.problem.invalidateLinearization(T);
+  unicycle.problem.calcDiff(xs, us);
+  BOOST_CHECK_EQUAL(unicycle.problem.get_nreused(), T - 1);
+  unicycle.problem.calcDiff(xs, us);
+  BOOST_CHECK_EQUAL(unicycle.problem.get_nreused(), T + 1);
+
+  // The appended node is evaluated after shifting the horizon
+  us[4][0] -= 1e-3;
+  unicycle.problem.calcDiff(xs, us);
+  unicycle.problem.circularAppend(unicycle.problem.get_runningModels()[0], unicycle.problem.get_runningDatas()[0]);
+  unicycle.problem.calcDiff(xs, us);
+  BOOST_CHECK_EQUAL(unicycle.problem.get_nreused(), T);
+  unicycle.problem.invalidateLinearizations();
+  unicycle.problem.calcDiff(xs, us);
+  BOOST_CHECK_EQUAL(unicycle.problem.get_nreused(), 0);
+
+  // The solver reports how many derivatives were reused, and it converges to the same solution
+  crocoddyl::ShootingProblem reference_problem(x, unicycle.running_models, &unicycle.model);
+  crocoddyl::SolverDDP reference(reference_problem);
+  crocoddyl::SolverDDP solver(unicycle.problem);
+  unicycle.problem.set_relinearization_tolerance(1e-12);
+  BOOST_CHECK(reference.solve());
+  BOOST_CHECK(solver.solve());
+  const crocoddyl::SolverTimings& timings = solver.get_timings();
+  BOOST_CHECK_EQUAL(timings.nlinearizations + timings.nreuses, timings.ncalcDiff * (T + 1));
+  BOOST_CHECK(timings.reuseRatio() >= 0. && timings.reuseRatio() <= 1.);
+  BOOST_CHECK_EQUAL(reference.get_timings().nreuses, 0);
+  BOOST_CHECK_CLOSE(solver.get_cost(), reference.get_cost(), 1e-6);
+}
+
+//____________________________________________________________________________//
+
+void test_multiple_shooting() {
+  const unsigned int T = 50;
+  UnicycleProblem unicycle(T);
+  std::vector<Eigen::VectorXd> xs(T + 1);
+  std::vector<Eigen::VectorXd> us(T, Eigen::VectorXd::Zero(unicycle.model.get_nu()));
+  for (unsigned int t = 0; t <= T; ++t) {
+    xs[t] = unicycle.model.get_state().rand();
+  }
+  crocoddyl::SolverFDDP solver(unicycle.problem);
+  BOOST_CHECK(!solver.get_multiple_shooting());
+  solver.solve(xs, us, 200);
+
+  // The trial states are predicted by the linearized dynamics, and the solver converges once the gaps are closed
+  crocoddyl::ShootingProblem ms_problem(unicycle.problem.get_x0(), unicycle.running_models, &unicycle.model);
+  crocoddyl::SolverFDDP ms_solver(ms_problem);
+  ms_solver.set_multiple_shooting(true);
+  BOOST_CHECK(ms_solver.solve(xs, us, 200));
+  BOOST_CHECK(std::abs(solver.get_cost() - ms_solver.get_cost()) < 1e-6 * (1. + std::abs(solver.get_cost())));
+  for (unsigned int t = 0; t < T; ++t) {
+    Eigen::VectorXd xnext(unicycle.model.get_state().get_nx());
+    unicycle.model.get_state().diff(ms_solver.get_xs()[t + 1], ms_problem.get_runningDatas()[t]->get_xnext(), xnext);
+    BOOST_CHECK(xnext.lpNorm<Eigen::Infinity>() <= 1e-6);
+  }
+}
+
+//____________________________________________________________________________//
+
+void test_batch() {
+  const unsigned int T = 30;
+  const unsigned int N = 6;
+  UnicycleProblem unicycle(T);
+  const unsigned int& nu = unicycle.model.get_nu();
+  std::vector<Eigen::VectorXd> x0s(N);
+  for (unsigned int i = 0; i < N; ++i) {
+    x0s[i] = unicycle.model.get_state().rand();
+  }
+
+  // Each solution is the one of solving its own problem
+  crocoddyl::SolverBatch batch(unicycle.problem, 2);
+  const Eigen::MatrixXd none;
+  BOOST_CHECK(batch.solve(x0s, none, none, 300));
+  BOOST_CHECK_EQUAL(batch.get_xs().rows(), (T + 1) * unicycle.model.get_state().get_nx());
+  BOOST_CHECK_EQUAL(batch.get_us().cols(), N);
+  BOOST_CHECK(batch.get_throughput() > 0.);
+  for (unsigned int i = 0; i < N; ++i) {
+    unicycle.problem.set_x0(x0s[i]);
+    crocoddyl::SolverFDDP solver(unicycle.problem);
+    BOOST_CHECK(solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 300));
+    BOOST_CHECK(batch.get_converged()[i]);
+    BOOST_CHECK_EQUAL(batch.get_iters()[i], solver.get_iter());
+    BOOST_CHECK_CLOSE(batch.get_costs()[i], solver.get_cost(), 1e-9);
+    for (unsigned int t = 0; t < T; ++t) {
+      BOOST_CHECK(batch.get_us().col(i).segment(t * nu, nu).isApprox(solver.get_us()[t]));
+    }
+  }
+
+  // Warm-starting from the solutions converges right away
+  const Eigen::MatrixXd xs = batch.get_xs();
+  const Eigen::MatrixXd us = batch.get_us();
+  BOOST_CHECK(batch.solve(x0s, xs, us, 100, true));
+  for (unsigned int i = 0; i < N; ++i) {
+    BOOST_CHECK(batch.get_iters()[i] <= 1);
+  }
+}
+
+//____________________________________________________________________________//
+
+void test_policy_publisher() {
+  const unsigned int T = 20;
+  const double dt = 1e-2;
+  UnicycleProblem unicycle(T);
+  crocoddyl::SolverFDDP solver(unicycle.problem);
+  crocoddyl::PolicyPublisher publisher(solver, dt);
+  std::vector<crocoddyl::CallbackAbstract*> callbacks(1, &publisher);
+  solver.setCallbacks(callbacks);
+  BOOST_CHECK(!publisher.has_update());
+  BOOST_CHECK_EQUAL(publisher.read().sequence, 0);
+
+  // The last accepted iteration is published
+  publisher.set_time(1.);
+  solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 100);
+  BOOST_CHECK(publisher.has_update());
+  const crocoddyl::PolicySnapshot& policy = publisher.read();
+  BOOST_CHECK(!publisher.has_update());
+  BOOST_CHECK(policy.sequence > 0);
+  BOOST_CHECK_EQUAL(policy.iter, solver.get_iter());
+  BOOST_CHECK_EQUAL(policy.cost, solver.get_cost());
+  for (unsigned int t = 0; t < T; ++t) {
+    BOOST_CHECK(policy.xs[t] == solver.get_xs()[t]);
+    BOOST_CHECK(policy.us[t] == solver.get_us()[t]);
+    BOOST_CHECK(policy.K[t] == solver.get_K()[t]);
+    BOOST_CHECK_CLOSE(policy.ts[t], 1. + t * dt, 1e-9);
+  }
+
+  // The reader keeps its snapshot until it reads a newer one
+  const unsigned long sequence = policy.sequence;
+  const crocoddyl::PolicySnapshot& same_policy = publisher.read();
+  BOOST_CHECK_EQUAL(&same_policy, &policy);
+  publisher.publish();
+  publisher.publish();
+  BOOST_CHECK_EQUAL(policy.sequence, sequence);
+  BOOST_CHECK_EQUAL(publisher.read().sequence, sequence + 2);
+
+  // The policy is u = us[t] - K[t] * dx at the nodes, and it is interpolated between them
+  crocoddyl::PolicyEvaluator evaluator(unicycle.problem);
+  const crocoddyl::PolicySnapshot& last_policy = publisher.read();
+  const Eigen::VectorXd x = unicycle.model.get_state().rand();
+  Eigen::VectorXd dx(unicycle.model.get_state().get_ndx());
+  Eigen::VectorXd u(unicycle.model.get_nu());
+  Eigen::VectorXd u2(unicycle.model.get_nu());
+  Eigen::VectorXd u3(unicycle.model.get_nu());
+  is_counting = true;
+  allocations = 0;
+  evaluator.evaluate(last_policy, 1. + 2 * dt, x, u2);
+  evaluator.evaluate(last_policy, 1. + 3 * dt, x, u3);
+  evaluator.evaluate(last_policy, 1. + 2.25 * dt, x, u);
+  is_counting = false;
+#ifdef __GLIBC__
+  BOOST_CHECK_EQUAL(allocations, 0);
+#endif
+  unicycle.model.get_state().diff(last_policy.xs[2], x, dx);
+  BOOST_CHECK(u2.isApprox(last_policy.us[2] - last_policy.K[2] * dx));
+  BOOST_CHECK(u.isApprox(0.75 * u2 + 0.25 * u3));
+  evaluator.evaluate(last_policy, 0., last_policy.xs[0], u);
+  BOOST_CHECK(u.isApprox(last_policy.us[0]));
+}
+
+//____________________________________________________________________________//
+
+void test_solution_publisher() {
+  const unsigned int T = 20;
+  const std::size_t capacity = 4;
+  UnicycleProblem unicycle(T);
+  const unsigned int& nx = unicycle.model.get_state().get_nx();
+  const unsigned int& nu = unicycle.model.get_nu();
+  crocoddyl::SolverFDDP solver(unicycle.problem);
+  crocoddyl::SolutionPublisher publisher("/crocoddyl_test_solutions", unicycle.problem, capacity);
+  BOOST_CHECK(publisher.is_open());
+  std::vector<crocoddyl::CallbackAbstract*> callbacks(1, &publisher);
+  solver.setCallbacks(callbacks);
+
+  crocoddyl::SolutionReader reader("/crocoddyl_test_solutions");
+  BOOST_CHECK(reader.is_open());
+  BOOST_CHECK_EQUAL(reader.get_T(), T);
+  BOOST_CHECK_EQUAL(reader.get_nxs(), (T + 1) * nx);
+  BOOST_CHECK_EQUAL(reader.get_nus(), T * nu);
+  crocoddyl::SolutionStats stats;
+  Eigen::VectorXd xs, us;
+  BOOST_CHECK(!reader.read_last(stats, xs, us));
+
+  // Each accepted iteration is published, and the ring keeps the last ones
+  solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 100);
+  const boost::uint64_t published = reader.get_published();
+  BOOST_CHECK(published > capacity);
+  BOOST_CHECK_EQUAL(publisher.get_published(), published);
+  BOOST_CHECK(reader.read_last(stats, xs, us));
+  BOOST_CHECK_EQUAL(stats.index, published - 1);
+  BOOST_CHECK_EQUAL(stats.iter, solver.get_iter());
+  BOOST_CHECK_EQUAL(stats.cost, solver.get_cost());
+  BOOST_CHECK_EQUAL(stats.feasible, solver.get_isFeasible());
+  for (unsigned int t = 0; t < T; ++t) {
+    BOOST_CHECK(xs.segment(t * nx, nx) == solver.get_xs()[t]);
+    BOOST_CHECK(us.segment(t * nu, nu) == solver.get_us()[t]);
+  }
+  BOOST_CHECK(reader.read(published - capacity, stats, xs, us));
+  BOOST_CHECK_EQUAL(stats.index, published - capacity);
+  BOOST_CHECK(!reader.read(published - capacity - 1, stats, xs, us));
+  BOOST_CHECK(!reader.read(published, stats, xs, us));
+
+  // A new publisher with the same name doesn't modify the segment that is mapped by the reader
+  crocoddyl::SolutionPublisher new_publisher("/crocoddyl_test_solutions", unicycle.problem, capacity);
+  BOOST_CHECK(new_publisher.is_open());
+  BOOST_CHECK_EQUAL(reader.get_published(), published);
+  BOOST_CHECK(reader.read_last(stats, xs, us));
+  BOOST_CHECK_EQUAL(stats.index, published - 1);
+  crocoddyl::SolutionReader new_reader("/crocoddyl_test_solutions");
+  BOOST_CHECK(new_reader.is_open());
+  BOOST_CHECK_EQUAL(new_reader.get_published(), 0);
+}
+
+//____________________________________________________________________________//
+
+#ifdef CROCODDYL_WITH_ASYNC_CALLBACKS
+class IterationCallbackCollector : public crocoddyl::IterationCallbackAbstract {
+ public:
+  explicit IterationCallbackCollector(const long& delay = 0) : delay_(delay) {}
+
+  void operator()(const crocoddyl::IterationRecord& record) {
+    if (delay_ > 0) {
+      boost::this_thread::sleep(boost::posix_time::milliseconds(delay_));
+    }
+    records.push_back(record);
+    thread_ids.push_back(boost::this_thread::get_id());
+  }
+
+  std::vector<crocoddyl::IterationRecord> records;
+  std::vector<boost::thread::id> thread_ids;
+
+ private:
+  long delay_;
+};
+
+void test_callback_async() {
+  const unsigned int T = 20;
+  UnicycleProblem unicycle(T);
+  crocoddyl::SolverFDDP solver(unicycle.problem);
+  crocoddyl::CallbackAsync async;
+  IterationCallbackCollector collector;
+  async.setCallbacks(std::vector<crocoddyl::IterationCallbackAbstract*>(1, &collector));
+  solver.setCallbacks(std::vector<crocoddyl::CallbackAbstract*>(1, &async));
+
+  // The records are dispatched on another thread, and all of them are done when the solve returns (the last iteration
+  // runs the callbacks only if it converged)
+  bool is_solved = solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 50);
+  const std::size_t n_iters = is_solved ? solver.get_iter() + 1 : solver.get_iter();
+  BOOST_CHECK(n_iters > 1 && n_iters <= async.get_capacity());
+  BOOST_CHECK_EQUAL(async.get_dropped(), 0);
+  BOOST_CHECK_EQUAL(async.get_dispatched(), n_iters);
+  BOOST_CHECK_EQUAL(collector.records.size(), n_iters);
+  for (std::size_t i = 0; i < collector.records.size(); ++i) {
+    BOOST_CHECK_EQUAL(collector.records[i].iter, i);
+    BOOST_CHECK(collector.thread_ids[i] != boost::this_thread::get_id());
+  }
+  BOOST_CHECK_EQUAL(collector.records.back().cost, solver.get_cost());
+  BOOST_CHECK_EQUAL(collector.records.back().stop, solver.get_stop());
+  BOOST_CHECK_EQUAL(collector.records.back().is_feasible, solver.get_isFeasible());
+
+  // A slow callback drops the records that don't fit in the ring, instead of slowing down the solver
+  crocoddyl::CallbackAsync small_async(1);
+  IterationCallbackCollector slow_collector(5);
+  small_async.setCallbacks(std::vector<crocoddyl::IterationCallbackAbstract*>(1, &slow_collector));
+  solver.setCallbacks(std::vector<crocoddyl::CallbackAbstract*>(1, &small_async));
+  is_solved = solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 50);
+  const std::size_t n_slow_iters = is_solved ? solver.get_iter() + 1 : solver.get_iter();
+  BOOST_CHECK(small_async.get_dropped() > 0);
+  BOOST_CHECK_EQUAL(small_async.get_dispatched() + small_async.get_dropped(), n_slow_iters);
+  BOOST_CHECK_EQUAL(slow_collector.records.size(), small_async.get_dispatched());
+}
+#endif
+
+//____________________________________________________________________________//
+
+template <typename Solver>
+void test_history() {
+  const unsigned int T = 20;
+  UnicycleProblem unicycle(T);
+  Solver solver(unicycle.problem);
+  BOOST_CHECK_EQUAL(solver.get_history_capacity(), 256);
+  BOOST_CHECK_EQUAL(solver.get_history().rows(), 0);
+
+  // There is a row per iteration that ran the callbacks, and the last one has the values of the solver
+  const bool is_solved = solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 50);
+  const crocoddyl::SolverAbstract::HistoryMap history = solver.get_history();
+  const unsigned int n_iters = is_solved ? solver.get_iter() + 1 : solver.get_iter();
+  BOOST_CHECK_EQUAL(history.rows(), n_iters);
+  BOOST_CHECK_EQUAL(history.cols(), crocoddyl::SolverHistoryNbFields);
+  const int last = static_cast<int>(history.rows()) - 1;
+  BOOST_CHECK_EQUAL(history(last, crocoddyl::SolverHistoryCost), solver.get_cost());
+  BOOST_CHECK_EQUAL(history(last, crocoddyl::SolverHistoryStop), solver.get_stop());
+  BOOST_CHECK_EQUAL(history(last, crocoddyl::SolverHistoryStepLength), solver.get_stepLength());
+  BOOST_CHECK_EQUAL(history(last, crocoddyl::SolverHistoryXReg), solver.get_xreg());
+  BOOST_CHECK_EQUAL(history(last, crocoddyl::SolverHistoryDVexp), solver.get_dVexp());
+  BOOST_CHECK_EQUAL(history(last, crocoddyl::SolverHistoryFeasible), solver.get_isFeasible() ? 1. : 0.);
+  BOOST_CHECK_EQUAL(history(last, crocoddyl::SolverHistoryBackwardPass), solver.get_iterTimings().backwardPass);
+  BOOST_CHECK(history.col(crocoddyl::SolverHistoryCalcDiff).minCoeff() >= 0.);
+  BOOST_CHECK(history.col(crocoddyl::SolverHistoryCalcDiff).sum() <= solver.get_timings().calcDiff + 1e-9);
+
+  // The iterations beyond the capacity aren't recorded, and the solves don't reallocate the history
+  const boost::shared_ptr<const crocoddyl::SolverAbstract::HistoryMatrix> storage = solver.get_history_storage();
+  const crocoddyl::SolverAbstract::HistoryMatrix values = history;
+  solver.set_history_capacity(2);
+  const double* data = solver.get_history().data();
+  solver.solve(crocoddyl::DEFAULT_VECTOR, crocoddyl::DEFAULT_VECTOR, 50);
+  BOOST_CHECK_EQUAL(solver.get_history().rows(), 2);
+  BOOST_CHECK_EQUAL(solver.get_history().data(), data);
+
+  // The owners of the previous storage keep the previous history
+  BOOST_CHECK(storage->topRows(values.rows()) == values);
+}
+
+//____________________________________________________________________________//
+
+void register_solvers_unit_tests() {
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_solve_does_not_allocate<crocoddyl::SolverDDP>, true, false)));
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_solve_does_not_allocate<crocoddyl::SolverDDP>, false, false)));
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_solve_does_not_allocate<crocoddyl::SolverFDDP>, true, false)));
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_solve_does_not_allocate<crocoddyl::SolverFDDP>, false, false)));
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_solve_does_not_allocate<crocoddyl::SolverBoxDDP>, true, false)));
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_solve_does_not_allocate<crocoddyl::SolverDDP>, true, true)));
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_solve_does_not_allocate<crocoddyl::SolverFDDP>, false, true)));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_timings<crocoddyl::SolverDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_timings<crocoddyl::SolverFDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_riccati_workspace));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_backward_pass_is_symmetric<crocoddyl::SolverDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_backward_pass_is_symmetric<crocoddyl::SolverFDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_sqrt_riccati<crocoddyl::SolverDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_sqrt_riccati<crocoddyl::SolverFDDP>));
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_partitioned_riccati<crocoddyl::SolverDDP>, false)));
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_partitioned_riccati<crocoddyl::SolverFDDP>, false)));
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_partitioned_riccati<crocoddyl::SolverFDDP>, true)));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_failed_node<crocoddyl::SolverDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_failed_node<crocoddyl::SolverFDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_non_convex_node<crocoddyl::SolverDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_non_convex_node<crocoddyl::SolverFDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_cost_lower_bound<crocoddyl::SolverDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_cost_lower_bound<crocoddyl::SolverFDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_time_budget<crocoddyl::SolverDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_time_budget<crocoddyl::SolverFDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_lazy_relinearization));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_multiple_shooting));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_batch));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_policy_publisher));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_solution_publisher));
+#ifdef CROCODDYL_WITH_ASYNC_CALLBACKS
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_callback_async));
+#endif
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_history<crocoddyl::SolverDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_history<crocoddyl::SolverFDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_quasic_static_does_not_allocate));
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_solve_does_not_allocate<crocoddyl::SolverBoxDDP>, true, true)));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_mixed_state_dimensions<crocoddyl::SolverDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_mixed_state_dimensions<crocoddyl::SolverFDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_time_budget_keeps_gains<crocoddyl::SolverDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_time_budget_keeps_gains<crocoddyl::SolverFDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_box_qp_round_off));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_kkt_non_convex));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_parallel_line_search<crocoddyl::SolverDDP>));
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_parallel_line_search<crocoddyl::SolverFDDP>));
+}
+
+//____________________________________________________________________________//
+
+bool init_function() {
+  register_solvers_unit_tests();
+  return true;
+}
+
+//____________________________________________________________________________//
+
+int main(int argc, char** argv) { return ::boost::unit_test::unit_test_main(&init_function, argc, argv); }
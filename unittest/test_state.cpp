@@ -10,11 +10,15 @@
 #define BOOST_TEST_ALTERNATIVE_INIT_API
 #include <boost/test/included/unit_test.hpp>
 #include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
 #include "crocoddyl/core/state-base.hpp"
 #include "crocoddyl/core/states/euclidean.hpp"
 #include "crocoddyl/core/states/unicycle.hpp"
 #include "crocoddyl/core/numdiff/state.hpp"
+#include "crocoddyl/multibody/states/multibody.hpp"
+#include <pinocchio/parsers/sample-models.hpp>
 #include <Eigen/Dense>
+#include <vector>
 
 using namespace boost::unit_test;
 
@@ -278,6 +282,116 @@ void test_velocity_from_Jintegrate_Jdiff(crocoddyl::StateAbstract& state) {
 
 //____________________________________________________________________________//
 
+struct StateOperationsSample {
+  Eigen::VectorXd x0, x1, dx;
+  Eigen::VectorXd diff, integrate;
+  Eigen::MatrixXd Jdiff_first, Jdiff_second;
+  Eigen::MatrixXd Jint_first, Jint_second;
+};
+
+struct StateOperations {
+  explicit StateOperations(crocoddyl::StateAbstract& state) : state(state) {}
+
+  void operator()(StateOperationsSample& sample) {
+    state.diff(sample.x0, sample.x1, sample.diff);
+    state.integrate(sample.x0, sample.dx, sample.integrate);
+    state.Jdiff(sample.x0, sample.x1, sample.Jdiff_first, sample.Jdiff_second);
+    state.Jintegrate(sample.x0, sample.dx, sample.Jint_first, sample.Jint_second);
+  }
+
+  crocoddyl::StateAbstract& state;
+};
+
+// The finite differences are computed in the workspace of the caller, so each copy has its own one
+struct StateNumDiffOperations {
+  explicit StateNumDiffOperations(crocoddyl::StateNumDiff& state) : state(state), data(state.createData()) {}
+  StateNumDiffOperations(const StateNumDiffOperations& other) : state(other.state), data(other.state.createData()) {}
+
+  void operator()(StateOperationsSample& sample) {
+    state.diff(sample.x0, sample.x1, sample.diff);
+    state.integrate(sample.x0, sample.dx, sample.integrate);
+    state.Jdiff(data, sample.x0, sample.x1, sample.Jdiff_first, sample.Jdiff_second);
+    state.Jintegrate(data, sample.x0, sample.dx, sample.Jint_first, sample.Jint_second);
+  }
+
+  crocoddyl::StateNumDiff& state;
+  boost::shared_ptr<crocoddyl::StateDataNumDiff> data;
+};
+
+template <typename Operations>
+void run_state_operations(Operations operations, const std::vector<StateOperationsSample>* samples,
+                          unsigned int offset, unsigned int niter, bool* success) {
+  // Each thread owns its output buffers and its copy of the operations, the state is the only shared object
+  StateOperationsSample out = samples->front();
+  *success = true;
+  for (unsigned int i = 0; i < niter; ++i) {
+    const StateOperationsSample& ref = (*samples)[(offset + i) % samples->size()];
+    out.x0 = ref.x0;
+    out.x1 = ref.x1;
+    out.dx = ref.dx;
+    operations(out);
+    if (out.diff != ref.diff || out.integrate != ref.integrate || out.Jdiff_first != ref.Jdiff_first ||
+        out.Jdiff_second != ref.Jdiff_second || out.Jint_first != ref.Jint_first ||
+        out.Jint_second != ref.Jint_second) {
+      *success = false;
+    }
+  }
+}
+
+template <typename Operations>
+void test_operations_reentrancy(crocoddyl::StateAbstract& state, Operations operations) {
+  const unsigned int nsamples = 16;
+  const unsigned int nthreads = 8;
+  const unsigned int niter = 200;
+
+  // Computing the reference values serially
+  std::vector<StateOperationsSample> samples(nsamples);
+  for (unsigned int i = 0; i < nsamples; ++i) {
+    StateOperationsSample& sample = samples[i];
+    sample.x0 = state.rand();
+    sample.x1 = state.rand();
+    sample.dx = Eigen::VectorXd::Random(state.get_ndx());
+    sample.diff.resize(state.get_ndx());
+    sample.integrate.resize(state.get_nx());
+    sample.Jdiff_first.resize(state.get_ndx(), state.get_ndx());
+    sample.Jdiff_second.resize(state.get_ndx(), state.get_ndx());
+    sample.Jint_first.resize(state.get_ndx(), state.get_ndx());
+    sample.Jint_second.resize(state.get_ndx(), state.get_ndx());
+    operations(sample);
+  }
+
+  // Running the same operations concurrently on the shared state. Note that the Boost.Test assertions are not
+  // thread-safe, so we check the results after joining the threads
+  bool success[nthreads];
+  boost::thread_group threads;
+  for (unsigned int i = 0; i < nthreads; ++i) {
+    threads.create_thread(boost::bind(&run_state_operations<Operations>, operations, &samples, i, niter, &success[i]));
+  }
+  threads.join_all();
+
+  for (unsigned int i = 0; i < nthreads; ++i) {
+    BOOST_CHECK(success[i]);
+  }
+}
+
+void test_state_reentrancy(crocoddyl::StateAbstract& state) {
+  test_operations_reentrancy(state, StateOperations(state));
+}
+
+void test_state_numdiff_reentrancy(crocoddyl::StateAbstract& state) {
+  crocoddyl::StateNumDiff state_num_diff(state);
+  test_operations_reentrancy(state_num_diff, StateNumDiffOperations(state_num_diff));
+}
+
+void test_state_multibody_reentrancy() {
+  pinocchio::Model model;
+  pinocchio::buildModels::humanoidRandom(model);
+  crocoddyl::StateMultibody state(model);
+  test_state_reentrancy(state);
+}
+
+//____________________________________________________________________________//
+
 void register_state_vector_unit_tests() {
   int nx = 10;
   double num_diff_modifier = 1e4;
@@ -313,6 +427,17 @@ void register_state_vector_unit_tests() {
 
   framework::master_test_suite().add(
       BOOST_TEST_CASE(boost::bind(&test_velocity_from_Jintegrate_Jdiff, crocoddyl::StateVector(nx))));
+
+  framework::master_test_suite().add(BOOST_TEST_CASE(boost::bind(&test_state_reentrancy, crocoddyl::StateVector(nx))));
+
+  framework::master_test_suite().add(
+      BOOST_TEST_CASE(boost::bind(&test_state_numdiff_reentrancy, crocoddyl::StateVector(nx))));
+}
+
+//____________________________________________________________________________//
+
+void register_state_multibody_unit_tests() {
+  framework::master_test_suite().add(BOOST_TEST_CASE(&test_state_multibody_reentrancy));
 }
 
 //____________________________________________________________________________//
@@ -320,6 +445,8 @@ void register_state_vector_unit_tests() {
 bool init_function() {
   // Here we test the state_vector
   register_state_vector_unit_tests();
+  // Here we test the state_multibody
+  register_state_multibody_unit_tests();
   return true;
 }
 